@@ -0,0 +1,103 @@
+// sol3
+
+// The MIT License (MIT)
+
+// Copyright (c) 2013-2020 Rapptz, ThePhD and contributors
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "sol_benchmark.hpp"
+
+#include <map>
+#include <numeric>
+
+namespace {
+	constexpr std::size_t container_size = 256;
+
+	std::vector<int> make_numbers() {
+		std::vector<int> numbers(container_size);
+		std::iota(numbers.begin(), numbers.end(), 1);
+		return numbers;
+	}
+
+	void run_lua_iteration(sol_benchmarks::state& st, sol::state& lua, const char* loop) {
+		std::string source = std::string("return function() local c = target local sum = 0 ") + loop + " return sum end";
+		sol::function iterate = lua.safe_script(source);
+		st.run(
+		     [&]() {
+			     int sum = iterate();
+			     sol_benchmarks::do_not_optimize(sum);
+		     },
+		     container_size);
+	}
+} // namespace
+
+SOL_BENCHMARK("container/vector ipairs")(sol_benchmarks::state& st) {
+	sol::state lua;
+	lua.open_libraries(sol::lib::base);
+	lua["target"] = make_numbers();
+	run_lua_iteration(st, lua, "for i, v in ipairs(c) do sum = sum + v end");
+}
+
+SOL_BENCHMARK("container/vector pairs")(sol_benchmarks::state& st) {
+	sol::state lua;
+	lua.open_libraries(sol::lib::base);
+	lua["target"] = make_numbers();
+	run_lua_iteration(st, lua, "for k, v in pairs(c) do sum = sum + v end");
+}
+
+SOL_BENCHMARK("container/vector index")(sol_benchmarks::state& st) {
+	sol::state lua;
+	lua["target"] = make_numbers();
+	run_lua_iteration(st, lua, "for i = 1, #c do sum = sum + c[i] end");
+}
+
+SOL_BENCHMARK("container/map pairs")(sol_benchmarks::state& st) {
+	sol::state lua;
+	lua.open_libraries(sol::lib::base);
+	std::map<int, int> numbers;
+	for (int i = 1; i <= static_cast<int>(container_size); ++i) {
+		numbers.emplace(i, i);
+	}
+	lua["target"] = std::move(numbers);
+	run_lua_iteration(st, lua, "for k, v in pairs(c) do sum = sum + v end");
+}
+
+SOL_BENCHMARK("container/table to vector")(sol_benchmarks::state& st) {
+	sol::state lua;
+	lua["target"] = sol::as_table(make_numbers());
+	sol::object target = lua["target"];
+	st.run(
+	     [&]() {
+		     std::vector<int> numbers = target.as<std::vector<int>>();
+		     sol_benchmarks::do_not_optimize(numbers);
+	     },
+	     container_size);
+}
+
+SOL_BENCHMARK("container/vector as_table push")(sol_benchmarks::state& st) {
+	sol::state lua;
+	std::vector<int> numbers = make_numbers();
+	lua_State* L = lua.lua_state();
+	st.run(
+	     [&]() {
+		     sol::stack::push(L, sol::as_table_ref(numbers));
+		     lua_pop(L, 1);
+	     },
+	     container_size);
+}
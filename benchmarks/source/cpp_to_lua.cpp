@@ -0,0 +1,98 @@
+// sol3
+
+// The MIT License (MIT)
+
+// Copyright (c) 2013-2020 Rapptz, ThePhD and contributors
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "sol_benchmark.hpp"
+
+namespace {
+	constexpr const char add_script[] = "function add(a, b) return a + b end";
+} // namespace
+
+SOL_BENCHMARK("cpp_to_lua/c api baseline")(sol_benchmarks::state& st) {
+	sol::state lua;
+	lua.safe_script(add_script);
+	lua_State* L = lua.lua_state();
+	lua_Integer i = 0;
+	st.run([&]() {
+		lua_getglobal(L, "add");
+		lua_pushinteger(L, i++);
+		lua_pushinteger(L, 1);
+		lua_call(L, 2, 1);
+		lua_Integer r = lua_tointeger(L, -1);
+		lua_pop(L, 1);
+		sol_benchmarks::do_not_optimize(r);
+	});
+}
+
+SOL_BENCHMARK("cpp_to_lua/function")(sol_benchmarks::state& st) {
+	sol::state lua;
+	lua.safe_script(add_script);
+	sol::function add = lua["add"];
+	int i = 0;
+	st.run([&]() {
+		int r = add(i++, 1);
+		sol_benchmarks::do_not_optimize(r);
+	});
+}
+
+SOL_BENCHMARK("cpp_to_lua/unsafe_function")(sol_benchmarks::state& st) {
+	sol::state lua;
+	lua.safe_script(add_script);
+	sol::unsafe_function add = lua["add"];
+	int i = 0;
+	st.run([&]() {
+		int r = add(i++, 1);
+		sol_benchmarks::do_not_optimize(r);
+	});
+}
+
+SOL_BENCHMARK("cpp_to_lua/protected_function")(sol_benchmarks::state& st) {
+	sol::state lua;
+	lua.safe_script(add_script);
+	sol::protected_function add = lua["add"];
+	int i = 0;
+	st.run([&]() {
+		int r = add(i++, 1);
+		sol_benchmarks::do_not_optimize(r);
+	});
+}
+
+SOL_BENCHMARK("cpp_to_lua/protected_function construction")(sol_benchmarks::state& st) {
+	sol::state lua;
+	lua.safe_script(add_script);
+	sol::function add = lua["add"];
+	st.run([&]() {
+		sol::protected_function pf = add;
+		sol_benchmarks::do_not_optimize(pf);
+	});
+}
+
+SOL_BENCHMARK("cpp_to_lua/multiple returns")(sol_benchmarks::state& st) {
+	sol::state lua;
+	lua.safe_script("function three(a) return a, a + 1, a + 2 end");
+	sol::function three = lua["three"];
+	int i = 0;
+	st.run([&]() {
+		std::tuple<int, int, int> r = three(i++);
+		sol_benchmarks::do_not_optimize(r);
+	});
+}
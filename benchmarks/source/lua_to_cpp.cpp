@@ -0,0 +1,95 @@
+// sol3
+
+// The MIT License (MIT)
+
+// Copyright (c) 2013-2020 Rapptz, ThePhD and contributors
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "sol_benchmark.hpp"
+
+namespace {
+	constexpr std::size_t calls_per_run = 256;
+
+	int free_function(int x) {
+		return x + 1;
+	}
+
+	struct member_holder {
+		int value = 0;
+
+		int add(int x) {
+			value += x;
+			return value;
+		}
+	};
+
+	int overloaded_int(int x) {
+		return x;
+	}
+
+	double overloaded_double_double(double x, double y) {
+		return x + y;
+	}
+
+	std::size_t overloaded_string(const std::string& s) {
+		return s.size();
+	}
+
+	// calls `target` from a Lua loop, so each sample is dominated by the Lua -> C++ transition
+	void run_lua_loop(sol_benchmarks::state& st, sol::state& lua, const char* loop_body) {
+		std::string source = std::string("return function(n) local f = target for i = 1, n do ") + loop_body + " end end";
+		sol::function loop = lua.safe_script(source);
+		st.run([&]() { loop(calls_per_run); }, calls_per_run);
+	}
+} // namespace
+
+SOL_BENCHMARK("lua_to_cpp/free function")(sol_benchmarks::state& st) {
+	sol::state lua;
+	lua.set_function("target", &free_function);
+	run_lua_loop(st, lua, "f(i)");
+}
+
+SOL_BENCHMARK("lua_to_cpp/c_call free function")(sol_benchmarks::state& st) {
+	sol::state lua;
+	lua.set_function("target", sol::c_call<decltype(&free_function), &free_function>);
+	run_lua_loop(st, lua, "f(i)");
+}
+
+SOL_BENCHMARK("lua_to_cpp/member function")(sol_benchmarks::state& st) {
+	sol::state lua;
+	lua.new_usertype<member_holder>("member_holder", "add", &member_holder::add);
+	lua["target"] = member_holder {};
+	run_lua_loop(st, lua, "f:add(1)");
+}
+
+SOL_BENCHMARK("lua_to_cpp/overloaded function")(sol_benchmarks::state& st) {
+	sol::state lua;
+	lua.set_function("target", sol::overload(&overloaded_string, &overloaded_double_double, &overloaded_int));
+	run_lua_loop(st, lua, "f(i)");
+}
+
+SOL_BENCHMARK("lua_to_cpp/stateful lambda")(sol_benchmarks::state& st) {
+	sol::state lua;
+	int total = 0;
+	lua.set_function("target", [total](int x) mutable {
+		total += x;
+		return total;
+	});
+	run_lua_loop(st, lua, "f(i)");
+}
@@ -0,0 +1,238 @@
+// sol3
+
+// The MIT License (MIT)
+
+// Copyright (c) 2013-2020 Rapptz, ThePhD and contributors
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "sol_benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+
+namespace sol_benchmarks {
+
+	std::vector<benchmark>& benchmarks() {
+		static std::vector<benchmark> all;
+		return all;
+	}
+
+	void state::finish() {
+		std::vector<double> sorted = m_result.sample_ns;
+		std::sort(sorted.begin(), sorted.end());
+		if (sorted.empty()) {
+			return;
+		}
+		double sum = std::accumulate(sorted.begin(), sorted.end(), 0.0);
+		double count = static_cast<double>(sorted.size());
+		m_result.mean_ns = sum / count;
+		m_result.min_ns = sorted.front();
+		m_result.max_ns = sorted.back();
+		std::size_t middle = sorted.size() / 2;
+		m_result.median_ns = sorted.size() % 2 == 0 ? (sorted[middle - 1] + sorted[middle]) / 2 : sorted[middle];
+		double squares = 0;
+		for (double sample : sorted) {
+			squares += (sample - m_result.mean_ns) * (sample - m_result.mean_ns);
+		}
+		m_result.stddev_ns = std::sqrt(squares / count);
+	}
+
+	namespace {
+		std::string json_escape(const std::string& s) {
+			std::string escaped;
+			escaped.reserve(s.size());
+			for (char c : s) {
+				switch (c) {
+				case '"':
+					escaped += "\\\"";
+					break;
+				case '\\':
+					escaped += "\\\\";
+					break;
+				case '\n':
+					escaped += "\\n";
+					break;
+				default:
+					if (static_cast<unsigned char>(c) < 0x20) {
+						char buffer[8];
+						std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned>(c));
+						escaped += buffer;
+					}
+					else {
+						escaped += c;
+					}
+					break;
+				}
+			}
+			return escaped;
+		}
+
+		const char* lua_version_name() {
+#if defined(LUAJIT_VERSION)
+			return LUAJIT_VERSION;
+#elif defined(LUA_RELEASE)
+			return LUA_RELEASE;
+#else
+			return LUA_VERSION;
+#endif
+		}
+
+		const char* compiler_name() {
+#if defined(__clang__)
+			return "clang " __clang_version__;
+#elif defined(__GNUC__)
+			return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+			return "msvc";
+#else
+			return "unknown";
+#endif
+		}
+
+		std::string utc_date() {
+			std::time_t now = std::time(nullptr);
+			char buffer[32] {};
+			std::tm* utc = std::gmtime(&now);
+			if (utc == nullptr || std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", utc) == 0) {
+				return std::string();
+			}
+			return buffer;
+		}
+
+		void write_json(std::ostream& out, const std::vector<result>& results) {
+			out << std::setprecision(6) << std::fixed;
+			out << "{\n";
+			out << "\t\"context\": {\n";
+			out << "\t\t\"date\": \"" << utc_date() << "\",\n";
+			out << "\t\t\"sol_version\": \"" << SOL_VERSION_STRING << "\",\n";
+			out << "\t\t\"lua_version\": \"" << json_escape(lua_version_name()) << "\",\n";
+			out << "\t\t\"compiler\": \"" << json_escape(compiler_name()) << "\",\n";
+#if defined(NDEBUG)
+			out << "\t\t\"optimized\": true\n";
+#else
+			out << "\t\t\"optimized\": false\n";
+#endif
+			out << "\t},\n";
+			out << "\t\"benchmarks\": [";
+			for (std::size_t i = 0; i < results.size(); ++i) {
+				const result& r = results[i];
+				out << (i == 0 ? "\n" : ",\n");
+				out << "\t\t{\n";
+				out << "\t\t\t\"name\": \"" << json_escape(r.name) << "\",\n";
+				out << "\t\t\t\"iterations\": " << r.iterations << ",\n";
+				out << "\t\t\t\"samples\": " << r.sample_ns.size() << ",\n";
+				out << "\t\t\t\"mean_ns\": " << r.mean_ns << ",\n";
+				out << "\t\t\t\"median_ns\": " << r.median_ns << ",\n";
+				out << "\t\t\t\"min_ns\": " << r.min_ns << ",\n";
+				out << "\t\t\t\"max_ns\": " << r.max_ns << ",\n";
+				out << "\t\t\t\"stddev_ns\": " << r.stddev_ns << "\n";
+				out << "\t\t}";
+			}
+			out << (results.empty() ? "]\n" : "\n\t]\n");
+			out << "}\n";
+		}
+
+		void print_usage(const char* program) {
+			std::cout << "usage: " << program << " [--filter <substring>] [--samples <count>] [--min-batch-ms <milliseconds>] [--json <file|->] [--list]\n";
+		}
+	} // namespace
+
+} // namespace sol_benchmarks
+
+int main(int argc, char* argv[]) {
+	using namespace sol_benchmarks;
+
+	options opts;
+	std::string filter;
+	std::string json_path;
+	bool list_only = false;
+	for (int i = 1; i < argc; ++i) {
+		const char* arg = argv[i];
+		bool has_value = i + 1 < argc;
+		if (std::strcmp(arg, "--filter") == 0 && has_value) {
+			filter = argv[++i];
+		}
+		else if (std::strcmp(arg, "--samples") == 0 && has_value) {
+			opts.samples = static_cast<std::size_t>((std::max)(1L, std::strtol(argv[++i], nullptr, 10)));
+		}
+		else if (std::strcmp(arg, "--min-batch-ms") == 0 && has_value) {
+			opts.min_batch_time = std::chrono::milliseconds((std::max)(1L, std::strtol(argv[++i], nullptr, 10)));
+		}
+		else if (std::strcmp(arg, "--json") == 0 && has_value) {
+			json_path = argv[++i];
+		}
+		else if (std::strcmp(arg, "--list") == 0) {
+			list_only = true;
+		}
+		else {
+			print_usage(argv[0]);
+			return std::strcmp(arg, "--help") == 0 ? 0 : 1;
+		}
+	}
+
+	std::vector<benchmark> selected = benchmarks();
+	std::stable_sort(selected.begin(), selected.end(), [](const benchmark& l, const benchmark& r) { return std::strcmp(l.name, r.name) < 0; });
+	selected.erase(std::remove_if(selected.begin(),
+	                    selected.end(),
+	                    [&filter](const benchmark& b) { return !filter.empty() && std::string(b.name).find(filter) == std::string::npos; }),
+	     selected.end());
+
+	if (list_only) {
+		for (const benchmark& b : selected) {
+			std::cout << b.name << "\n";
+		}
+		return 0;
+	}
+
+	// human-readable results go to stderr when the JSON goes to stdout
+	std::ostream& report = json_path == "-" ? std::cerr : std::cout;
+	std::vector<result> results;
+	results.reserve(selected.size());
+	for (const benchmark& b : selected) {
+		result r;
+		r.name = b.name;
+		state st(opts, r);
+		b.function(st);
+		report << std::left << std::setw(48) << r.name << std::right << std::setw(14) << std::fixed << std::setprecision(2) << r.median_ns << " ns/op"
+		       << "  (min " << r.min_ns << ", max " << r.max_ns << ", " << r.iterations << " iterations x " << r.sample_ns.size() << ")" << std::endl;
+		results.push_back(std::move(r));
+	}
+
+	if (json_path == "-") {
+		write_json(std::cout, results);
+	}
+	else if (!json_path.empty()) {
+		std::ofstream out(json_path, std::ios::binary);
+		if (!out) {
+			std::cerr << "cannot open '" << json_path << "' for writing" << std::endl;
+			return 1;
+		}
+		write_json(out, results);
+	}
+	return 0;
+}
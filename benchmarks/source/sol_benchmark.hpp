@@ -0,0 +1,130 @@
+// sol3
+
+// The MIT License (MIT)
+
+// Copyright (c) 2013-2020 Rapptz, ThePhD and contributors
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SOL_BENCHMARKS_SOL_BENCHMARK_HPP
+#define SOL_BENCHMARKS_SOL_BENCHMARK_HPP
+
+#include <sol/sol.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace sol_benchmarks {
+
+	struct result {
+		std::string name;
+		std::size_t iterations = 0;
+		std::vector<double> sample_ns;
+		double mean_ns = 0;
+		double median_ns = 0;
+		double min_ns = 0;
+		double max_ns = 0;
+		double stddev_ns = 0;
+	};
+
+	struct options {
+		std::size_t samples = 10;
+		std::chrono::nanoseconds min_batch_time = std::chrono::milliseconds(20);
+	};
+
+	template <typename T>
+	inline void do_not_optimize(T&& value) {
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile const void* sink;
+		sink = static_cast<const void*>(&value);
+#endif
+	}
+
+	class state {
+	private:
+		const options& m_options;
+		result& m_result;
+
+		template <typename Fx>
+		static std::chrono::nanoseconds time_batch(Fx& fx, std::size_t iterations) {
+			auto start = std::chrono::steady_clock::now();
+			for (std::size_t i = 0; i < iterations; ++i) {
+				fx();
+			}
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+		}
+
+		void finish();
+
+	public:
+		state(const options& opts, result& r) : m_options(opts), m_result(r) {
+		}
+
+		// calibrates a batch size that runs for at least the minimum batch time,
+		// then records one time-per-operation sample per batch;
+		// operations_per_call is for callables that loop internally (e.g., a Lua-side loop)
+		template <typename Fx>
+		void run(Fx&& fx, std::size_t operations_per_call = 1) {
+			std::size_t iterations = 1;
+			for (;;) {
+				std::chrono::nanoseconds elapsed = time_batch(fx, iterations);
+				if (elapsed >= m_options.min_batch_time || iterations >= (static_cast<std::size_t>(1) << 30)) {
+					break;
+				}
+				iterations *= 2;
+			}
+			m_result.iterations = iterations * operations_per_call;
+			m_result.sample_ns.clear();
+			for (std::size_t sample = 0; sample < m_options.samples; ++sample) {
+				std::chrono::nanoseconds elapsed = time_batch(fx, iterations);
+				m_result.sample_ns.push_back(static_cast<double>(elapsed.count()) / static_cast<double>(iterations * operations_per_call));
+			}
+			finish();
+		}
+	};
+
+	using benchmark_function = void (*)(state&);
+
+	struct benchmark {
+		const char* name;
+		benchmark_function function;
+	};
+
+	std::vector<benchmark>& benchmarks();
+
+	struct registrar {
+		registrar(const char* name, benchmark_function function) {
+			benchmarks().push_back(benchmark { name, function });
+		}
+	};
+
+} // namespace sol_benchmarks
+
+#define SOL_BENCHMARK_CONCAT_I_(a, b) a##b
+#define SOL_BENCHMARK_CONCAT_(a, b) SOL_BENCHMARK_CONCAT_I_(a, b)
+#define SOL_BENCHMARK_NAMED_(fx, name)                                                                            \
+	static void fx(::sol_benchmarks::state&);                                                                     \
+	static const ::sol_benchmarks::registrar SOL_BENCHMARK_CONCAT_(fx, _registrar) { name, &fx };                 \
+	static void fx
+#define SOL_BENCHMARK(name) SOL_BENCHMARK_NAMED_(SOL_BENCHMARK_CONCAT_(sol_benchmark_, __LINE__), name)
+
+#endif // SOL_BENCHMARKS_SOL_BENCHMARK_HPP
@@ -0,0 +1,87 @@
+// sol3
+
+// The MIT License (MIT)
+
+// Copyright (c) 2013-2020 Rapptz, ThePhD and contributors
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "sol_benchmark.hpp"
+
+namespace {
+	const std::string short_string = "entity.position";
+	const std::string long_string(1024, 'x');
+
+	template <typename String>
+	void push_pop(sol_benchmarks::state& st, const String& value) {
+		sol::state lua;
+		lua_State* L = lua.lua_state();
+		st.run([&]() {
+			sol::stack::push(L, value);
+			lua_pop(L, 1);
+		});
+	}
+
+	template <typename String>
+	void get_from(sol_benchmarks::state& st, const std::string& source) {
+		sol::state lua;
+		lua_State* L = lua.lua_state();
+		sol::stack::push(L, source);
+		st.run([&]() {
+			String value = sol::stack::get<String>(L, -1);
+			sol_benchmarks::do_not_optimize(value);
+		});
+		lua_pop(L, 1);
+	}
+} // namespace
+
+SOL_BENCHMARK("string/push short std::string")(sol_benchmarks::state& st) {
+	push_pop(st, short_string);
+}
+
+SOL_BENCHMARK("string/push long std::string")(sol_benchmarks::state& st) {
+	push_pop(st, long_string);
+}
+
+SOL_BENCHMARK("string/push const char*")(sol_benchmarks::state& st) {
+	push_pop(st, short_string.c_str());
+}
+
+SOL_BENCHMARK("string/push std::u16string")(sol_benchmarks::state& st) {
+	push_pop(st, std::u16string(u"entity.position.with.a.longer.utf16.name"));
+}
+
+SOL_BENCHMARK("string/push std::u32string")(sol_benchmarks::state& st) {
+	push_pop(st, std::u32string(U"entity.position.with.a.longer.utf32.name"));
+}
+
+SOL_BENCHMARK("string/push std::wstring")(sol_benchmarks::state& st) {
+	push_pop(st, std::wstring(L"entity.position.with.a.longer.wide.name"));
+}
+
+SOL_BENCHMARK("string/get std::string")(sol_benchmarks::state& st) {
+	get_from<std::string>(st, short_string);
+}
+
+SOL_BENCHMARK("string/get std::string_view")(sol_benchmarks::state& st) {
+	get_from<std::string_view>(st, short_string);
+}
+
+SOL_BENCHMARK("string/get std::u16string")(sol_benchmarks::state& st) {
+	get_from<std::u16string>(st, "entity.position.with.a.longer.utf16.name");
+}
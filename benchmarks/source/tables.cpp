@@ -0,0 +1,109 @@
+// sol3
+
+// The MIT License (MIT)
+
+// Copyright (c) 2013-2020 Rapptz, ThePhD and contributors
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "sol_benchmark.hpp"
+
+namespace {
+	constexpr std::size_t traversed_elements = 64;
+} // namespace
+
+SOL_BENCHMARK("table/global get")(sol_benchmarks::state& st) {
+	sol::state lua;
+	lua["value"] = 24;
+	st.run([&]() {
+		int v = lua["value"];
+		sol_benchmarks::do_not_optimize(v);
+	});
+}
+
+SOL_BENCHMARK("table/global set")(sol_benchmarks::state& st) {
+	sol::state lua;
+	int i = 0;
+	st.run([&]() { lua["value"] = i++; });
+}
+
+SOL_BENCHMARK("table/integer key get")(sol_benchmarks::state& st) {
+	sol::state lua;
+	sol::table t = lua.create_table_with(1, 10, 2, 20, 3, 30);
+	st.run([&]() {
+		int v = t[2];
+		sol_benchmarks::do_not_optimize(v);
+	});
+}
+
+SOL_BENCHMARK("table/integer key set")(sol_benchmarks::state& st) {
+	sol::state lua;
+	sol::table t = lua.create_table(3, 0);
+	int i = 0;
+	st.run([&]() { t[2] = i++; });
+}
+
+SOL_BENCHMARK("table/nested get")(sol_benchmarks::state& st) {
+	sol::state lua;
+	lua.safe_script("config = { window = { size = { width = 1280 } } }");
+	st.run([&]() {
+		int width = lua["config"]["window"]["size"]["width"];
+		sol_benchmarks::do_not_optimize(width);
+	});
+}
+
+SOL_BENCHMARK("table/get_or")(sol_benchmarks::state& st) {
+	sol::state lua;
+	sol::table t = lua.create_table();
+	st.run([&]() {
+		int v = t.get_or("missing", 5);
+		sol_benchmarks::do_not_optimize(v);
+	});
+}
+
+SOL_BENCHMARK("table/traverse range-for")(sol_benchmarks::state& st) {
+	sol::state lua;
+	sol::table t = lua.create_table(static_cast<int>(traversed_elements), 0);
+	for (std::size_t i = 1; i <= traversed_elements; ++i) {
+		t[i] = static_cast<int>(i);
+	}
+	st.run(
+	     [&]() {
+		     int sum = 0;
+		     for (const auto& kvp : t) {
+			     sum += kvp.second.as<int>();
+		     }
+		     sol_benchmarks::do_not_optimize(sum);
+	     },
+	     traversed_elements);
+}
+
+SOL_BENCHMARK("table/traverse for_each")(sol_benchmarks::state& st) {
+	sol::state lua;
+	sol::table t = lua.create_table(static_cast<int>(traversed_elements), 0);
+	for (std::size_t i = 1; i <= traversed_elements; ++i) {
+		t[i] = static_cast<int>(i);
+	}
+	st.run(
+	     [&]() {
+		     int sum = 0;
+		     t.for_each([&sum](const sol::object&, const sol::object& value) { sum += value.as<int>(); });
+		     sol_benchmarks::do_not_optimize(sum);
+	     },
+	     traversed_elements);
+}
@@ -0,0 +1,136 @@
+// sol3
+
+// The MIT License (MIT)
+
+// Copyright (c) 2013-2020 Rapptz, ThePhD and contributors
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "sol_benchmark.hpp"
+
+namespace {
+	constexpr std::size_t accesses_per_run = 256;
+
+	struct vec {
+		double x = 0;
+		double y = 0;
+
+		double get_length2() const {
+			return x * x + y * y;
+		}
+
+		void set_y(double value) {
+			y = value;
+		}
+
+		double get_y() const {
+			return y;
+		}
+	};
+
+	struct base {
+		int base_value = 1;
+
+		virtual ~base() = default;
+
+		int get_base_value() const {
+			return base_value;
+		}
+	};
+
+	struct derived : base {
+		int derived_value = 2;
+	};
+
+	int take_base(const base& b) {
+		return b.base_value;
+	}
+
+	void register_vec(sol::state& lua) {
+		lua.new_usertype<vec>("vec", "x", &vec::x, "y", sol::property(&vec::get_y, &vec::set_y), "length2", &vec::get_length2);
+		lua["target"] = vec {};
+	}
+
+	void run_lua_loop(sol_benchmarks::state& st, sol::state& lua, const char* loop_body) {
+		std::string source = std::string("return function(n) local o = target local v = 0 for i = 1, n do ") + loop_body + " end return v end";
+		sol::function loop = lua.safe_script(source);
+		st.run(
+		     [&]() {
+			     double v = loop(accesses_per_run);
+			     sol_benchmarks::do_not_optimize(v);
+		     },
+		     accesses_per_run);
+	}
+} // namespace
+
+SOL_BENCHMARK("usertype/variable get")(sol_benchmarks::state& st) {
+	sol::state lua;
+	register_vec(lua);
+	run_lua_loop(st, lua, "v = o.x");
+}
+
+SOL_BENCHMARK("usertype/variable set")(sol_benchmarks::state& st) {
+	sol::state lua;
+	register_vec(lua);
+	run_lua_loop(st, lua, "o.x = i");
+}
+
+SOL_BENCHMARK("usertype/property get")(sol_benchmarks::state& st) {
+	sol::state lua;
+	register_vec(lua);
+	run_lua_loop(st, lua, "v = o.y");
+}
+
+SOL_BENCHMARK("usertype/property set")(sol_benchmarks::state& st) {
+	sol::state lua;
+	register_vec(lua);
+	run_lua_loop(st, lua, "o.y = i");
+}
+
+SOL_BENCHMARK("usertype/construct value")(sol_benchmarks::state& st) {
+	sol::state lua;
+	register_vec(lua);
+	run_lua_loop(st, lua, "v = vec.new()");
+}
+
+SOL_BENCHMARK("usertype/get from cpp")(sol_benchmarks::state& st) {
+	sol::state lua;
+	register_vec(lua);
+	sol::object target = lua["target"];
+	st.run([&]() {
+		vec& v = target.as<vec&>();
+		sol_benchmarks::do_not_optimize(v);
+	});
+}
+
+SOL_BENCHMARK("inheritance/derived as base argument")(sol_benchmarks::state& st) {
+	sol::state lua;
+	lua.new_usertype<base>("base", "base_value", &base::base_value);
+	lua.new_usertype<derived>("derived", sol::base_classes, sol::bases<base>(), "derived_value", &derived::derived_value);
+	lua.set_function("take_base", &take_base);
+	lua["target"] = derived {};
+	run_lua_loop(st, lua, "v = take_base(o)");
+}
+
+SOL_BENCHMARK("inheritance/base member on derived")(sol_benchmarks::state& st) {
+	sol::state lua;
+	lua.new_usertype<base>("base", "get_base_value", &base::get_base_value);
+	lua.new_usertype<derived>("derived", sol::base_classes, sol::bases<base>(), "derived_value", &derived::derived_value);
+	lua["target"] = derived {};
+	run_lua_loop(st, lua, "v = o:get_base_value()");
+}
@@ -0,0 +1,292 @@
+// sol3
+
+// The MIT License (MIT)
+
+// Copyright (c) 2013-2020 Rapptz, ThePhD and contributors
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SOL_ARRAY_VIEW_HPP
+#define SOL_ARRAY_VIEW_HPP
+
+#include <sol/usertype_container.hpp>
+
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+
+namespace sol {
+
+	// a non-owning view of a contiguous run of T:
+	// Lua sees it as a fixed-size container whose elements are read and written in place
+	template <typename T>
+	class array_view {
+	public:
+		typedef T element_type;
+		typedef std::remove_cv_t<T> value_type;
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef T* pointer;
+		typedef T& reference;
+		typedef T* iterator;
+		typedef T* const_iterator;
+
+	private:
+		template <typename C>
+		using is_viewable_container
+		     = meta::all<meta::neg<std::is_same<meta::unqualified_t<C>, array_view>>, std::is_convertible<decltype(std::declval<C&>().data()), pointer>>;
+
+		pointer m_data;
+		size_type m_size;
+
+	public:
+		constexpr array_view() noexcept : m_data(nullptr), m_size(0) {
+		}
+
+		constexpr array_view(pointer data_, size_type size_) noexcept : m_data(data_), m_size(size_) {
+		}
+
+		template <std::size_t N>
+		constexpr array_view(element_type (&arr)[N]) noexcept : m_data(arr), m_size(N) {
+		}
+
+		template <typename C, meta::enable<is_viewable_container<C>> = meta::enabler>
+		constexpr array_view(C& container) noexcept : m_data(container.data()), m_size(static_cast<size_type>(container.size())) {
+		}
+
+		constexpr pointer data() const noexcept {
+			return m_data;
+		}
+
+		constexpr size_type size() const noexcept {
+			return m_size;
+		}
+
+		constexpr bool empty() const noexcept {
+			return m_size == 0;
+		}
+
+		constexpr iterator begin() const noexcept {
+			return m_data;
+		}
+
+		constexpr iterator end() const noexcept {
+			return m_data + m_size;
+		}
+
+		constexpr reference operator[](size_type i) const noexcept {
+			return m_data[i];
+		}
+	};
+
+	template <typename T, std::size_t N>
+	array_view(T (&)[N]) -> array_view<T>;
+
+	template <typename C>
+	array_view(C&) -> array_view<std::remove_reference_t<decltype(*std::declval<C&>().data())>>;
+
+	template <typename T>
+	struct usertype_container<array_view<T>> : container_detail::usertype_container_default<array_view<T>> {
+	private:
+		typedef array_view<T> view;
+		typedef typename view::value_type value_type;
+		typedef std::integral_constant<bool, !std::is_const_v<T> && std::is_copy_assignable_v<value_type>> is_writable;
+
+		static view& get_self(lua_State* L) {
+#if SOL_IS_ON(SOL_SAFE_USERTYPE_I_)
+			auto p = stack::unqualified_check_get<view*>(L, 1);
+			if (!p) {
+				luaL_error(L,
+				     "sol: 'self' is not of type '%s' (pass 'self' as first argument with ':' or call on proper type)",
+				     detail::demangle<view>().c_str());
+			}
+			if (p.value() == nullptr) {
+				luaL_error(L, "sol: 'self' argument is nil (pass 'self' as first argument with ':' or call on a '%s' type)", detail::demangle<view>().c_str());
+			}
+			return *p.value();
+#else
+			return stack::unqualified_get<view>(L, 1);
+#endif // Safe getting with error
+		}
+
+		// 0-based offset of the key at `index`, or -1 when it is not an integer inside the view
+		static std::ptrdiff_t offset_of(lua_State* L, int index, const view& self) {
+			int isnum = 0;
+			lua_Integer key = lua_tointegerx(L, index, &isnum);
+			if (isnum == 0) {
+				return -1;
+			}
+			std::ptrdiff_t pos = static_cast<std::ptrdiff_t>(key) - static_cast<std::ptrdiff_t>(SOL_CONTAINER_START_INDEX_I_);
+			if (pos < 0 || pos >= static_cast<std::ptrdiff_t>(self.size())) {
+				return -1;
+			}
+			return pos;
+		}
+
+		static int push_element(lua_State* L, T& element) {
+			if constexpr (std::is_arithmetic_v<value_type>) {
+				return stack::push(L, element);
+			}
+			else {
+				return stack::stack_detail::push_reference<T&>(L, element);
+			}
+		}
+
+		static int read_only_error(lua_State* L) {
+			return luaL_error(L, "sol: cannot write to the elements of a read-only '%s'", detail::demangle<view>().c_str());
+		}
+
+		static int fixed_size_error(lua_State* L) {
+			return luaL_error(L, "sol: cannot change the size of a '%s'", detail::demangle<view>().c_str());
+		}
+
+		static int fill_call(lua_State* L) {
+			if constexpr (is_writable::value) {
+				auto& self = get_self(L);
+				decltype(auto) value = stack::unqualified_get<value_type>(L, 2);
+				std::fill(self.begin(), self.end(), value);
+				return 0;
+			}
+			else {
+				return read_only_error(L);
+			}
+		}
+
+		static int copy_from_table_call(lua_State* L) {
+			if constexpr (is_writable::value) {
+				auto& self = get_self(L);
+				luaL_checktype(L, 2, LUA_TTABLE);
+				std::ptrdiff_t first = 0;
+				if (lua_isnoneornil(L, 3) == 0) {
+					first = offset_of(L, 3, self);
+					if (first < 0) {
+						return luaL_error(L, "sol: starting index out of range for copy_from_table on '%s'", detail::demangle<view>().c_str());
+					}
+				}
+				std::size_t count = (std::min)(static_cast<std::size_t>(lua_rawlen(L, 2)), self.size() - static_cast<std::size_t>(first));
+				T* target = self.data() + first;
+				for (std::size_t i = 0; i < count; ++i) {
+					lua_rawgeti(L, 2, static_cast<lua_Integer>(i + 1));
+					target[i] = stack::unqualified_get<value_type>(L, -1);
+					lua_pop(L, 1);
+				}
+				return stack::push(L, count);
+			}
+			else {
+				return read_only_error(L);
+			}
+		}
+
+		static int copy_to_table_call(lua_State* L) {
+			auto& self = get_self(L);
+			luaL_checkstack(L, 2, detail::not_enough_stack_space_generic);
+			if (lua_istable(L, 2) == 0) {
+				lua_createtable(L, static_cast<int>(self.size()), 0);
+			}
+			else {
+				lua_pushvalue(L, 2);
+			}
+			T* source = self.data();
+			for (std::size_t i = 0; i < self.size(); ++i) {
+				push_element(L, source[i]);
+				lua_rawseti(L, -2, static_cast<lua_Integer>(i + 1));
+			}
+			return 1;
+		}
+
+	public:
+		static int get(lua_State* L) {
+			auto& self = get_self(L);
+			std::ptrdiff_t pos = offset_of(L, 2, self);
+			if (pos < 0) {
+				return stack::push(L, lua_nil);
+			}
+			return push_element(L, self.data()[pos]);
+		}
+
+		static int at(lua_State* L) {
+			return get(L);
+		}
+
+		static int index_get(lua_State* L) {
+			if (lua_type(L, 2) == LUA_TSTRING) {
+				// the bulk operations are looked up by name, since they are not part of the container interface
+				string_view name = stack::unqualified_get<string_view>(L, 2);
+				if (name == "fill") {
+					return stack::push(L, &detail::typed_static_trampoline<decltype(&fill_call), &fill_call>);
+				}
+				if (name == "copy_from_table") {
+					return stack::push(L, &detail::typed_static_trampoline<decltype(&copy_from_table_call), &copy_from_table_call>);
+				}
+				if (name == "copy_to_table") {
+					return stack::push(L, &detail::typed_static_trampoline<decltype(&copy_to_table_call), &copy_to_table_call>);
+				}
+				return stack::push(L, lua_nil);
+			}
+			return get(L);
+		}
+
+		static int set(lua_State* L) {
+			if constexpr (is_writable::value) {
+				auto& self = get_self(L);
+				std::ptrdiff_t pos = offset_of(L, 2, self);
+				if (pos < 0) {
+					return luaL_error(L, "sol: index out of bounds for '%s' (views cannot grow or shrink)", detail::demangle<view>().c_str());
+				}
+				self.data()[pos] = stack::unqualified_get<value_type>(L, 3);
+				return 0;
+			}
+			else {
+				return read_only_error(L);
+			}
+		}
+
+		static int index_set(lua_State* L) {
+			return set(L);
+		}
+
+		static int size(lua_State* L) {
+			auto& self = get_self(L);
+			return stack::push(L, self.size());
+		}
+
+		static int empty(lua_State* L) {
+			auto& self = get_self(L);
+			return stack::push(L, self.empty());
+		}
+
+		static int add(lua_State* L) {
+			return fixed_size_error(L);
+		}
+
+		static int insert(lua_State* L) {
+			return fixed_size_error(L);
+		}
+
+		static int erase(lua_State* L) {
+			return fixed_size_error(L);
+		}
+
+		static int clear(lua_State* L) {
+			return fixed_size_error(L);
+		}
+	};
+
+} // namespace sol
+
+#endif // SOL_ARRAY_VIEW_HPP
@@ -0,0 +1,281 @@
+// sol3
+
+// The MIT License (MIT)
+
+// Copyright (c) 2013-2020 Rapptz, ThePhD and contributors
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SOL_BYTECODE_CACHE_HPP
+#define SOL_BYTECODE_CACHE_HPP
+
+#include <sol/stack.hpp>
+#include <sol/bytecode.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+
+namespace sol {
+
+	struct bytecode_cache_stats {
+		// loads served from memory
+		std::size_t hits = 0;
+		// loads served from the cache directory
+		std::size_t disk_hits = 0;
+		// loads that had to parse the source file
+		std::size_t misses = 0;
+	};
+
+	// compiled chunks of script files, keyed by path, and checked against the file's size and modification time on every load;
+	// can be shared by any number of states, including states on different threads
+	class bytecode_cache : public detail::file_loader {
+	private:
+		struct file_stamp {
+			std::uint64_t size = 0;
+			std::int64_t modified = 0;
+
+			bool operator==(const file_stamp& right) const noexcept {
+				return size == right.size && modified == right.modified;
+			}
+		};
+
+		struct entry {
+			file_stamp stamp;
+			std::shared_ptr<const bytecode> code;
+		};
+
+		struct disk_header {
+			char magic[8];
+			std::uint32_t lua_version;
+			std::uint32_t luajit_version;
+			std::uint64_t size;
+			std::int64_t modified;
+			std::uint64_t path_size;
+		};
+
+		static constexpr char disk_magic[8] = { 's', 'o', 'l', '.', 'b', 'c', '\x01', '\n' };
+
+		std::mutex m_mutex;
+		std::unordered_map<std::string, entry> m_entries;
+		std::filesystem::path m_directory;
+		bytecode_cache_stats m_stats;
+
+		static bool stamp_of(const std::string& filename, file_stamp& stamp) {
+			std::error_code ec;
+			std::filesystem::path p(filename);
+			std::uintmax_t size = std::filesystem::file_size(p, ec);
+			if (ec) {
+				return false;
+			}
+			auto modified = std::filesystem::last_write_time(p, ec);
+			if (ec) {
+				return false;
+			}
+			stamp.size = static_cast<std::uint64_t>(size);
+			stamp.modified = static_cast<std::int64_t>(modified.time_since_epoch().count());
+			return true;
+		}
+
+		static int load_code(lua_State* L, const bytecode& code, const std::string& filename) {
+			// same chunk name luaL_loadfilex would give, so error messages and debug info do not change
+			std::string chunkname = "@" + filename;
+			return luaL_loadbufferx(L, reinterpret_cast<const char*>(code.data()), code.size(), chunkname.c_str(), "b");
+		}
+
+		std::filesystem::path disk_path(const std::string& filename) const {
+			char name[2 * sizeof(std::size_t) + 6];
+			std::snprintf(name, sizeof(name), "%0*zx.luac", static_cast<int>(2 * sizeof(std::size_t)), std::hash<std::string>()(filename));
+			return m_directory / name;
+		}
+
+		std::shared_ptr<const bytecode> read_disk(const std::string& filename, const file_stamp& stamp) const {
+			std::ifstream in(disk_path(filename), std::ios::binary);
+			if (!in) {
+				return nullptr;
+			}
+			disk_header header {};
+			in.read(reinterpret_cast<char*>(&header), sizeof(header));
+			if (!in || std::char_traits<char>::compare(header.magic, disk_magic, sizeof(disk_magic)) != 0
+			     || header.lua_version != static_cast<std::uint32_t>(SOL_LUA_VESION_I_) || header.luajit_version != static_cast<std::uint32_t>(SOL_LUAJIT_VERSION_I_)
+			     || header.size != stamp.size || header.modified != stamp.modified || header.path_size != filename.size()) {
+				return nullptr;
+			}
+			// the full path guards against two files hashing to the same cache file name
+			std::string path(filename.size(), '\0');
+			in.read(&path[0], static_cast<std::streamsize>(path.size()));
+			if (!in || path != filename) {
+				return nullptr;
+			}
+			std::streamoff first = in.tellg();
+			in.seekg(0, std::ios::end);
+			std::streamoff last = in.tellg();
+			if (!in || last <= first) {
+				return nullptr;
+			}
+			in.seekg(first);
+			auto code = std::make_shared<bytecode>(static_cast<std::size_t>(last - first));
+			in.read(reinterpret_cast<char*>(code->data()), static_cast<std::streamsize>(code->size()));
+			if (!in) {
+				return nullptr;
+			}
+			return code;
+		}
+
+		void write_disk(const std::string& filename, const file_stamp& stamp, const bytecode& code) const {
+			std::filesystem::path target = disk_path(filename);
+			std::filesystem::path temporary = target;
+			temporary += ".tmp";
+			{
+				std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+				if (!out) {
+					return;
+				}
+				disk_header header {};
+				std::char_traits<char>::copy(header.magic, disk_magic, sizeof(disk_magic));
+				header.lua_version = static_cast<std::uint32_t>(SOL_LUA_VESION_I_);
+				header.luajit_version = static_cast<std::uint32_t>(SOL_LUAJIT_VERSION_I_);
+				header.size = stamp.size;
+				header.modified = stamp.modified;
+				header.path_size = filename.size();
+				out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+				out.write(filename.data(), static_cast<std::streamsize>(filename.size()));
+				out.write(reinterpret_cast<const char*>(code.data()), static_cast<std::streamsize>(code.size()));
+				if (!out) {
+					return;
+				}
+			}
+			// readers in other processes only ever see a complete file
+			std::error_code ec;
+			std::filesystem::rename(temporary, target, ec);
+		}
+
+		void store(const std::string& filename, const file_stamp& stamp, std::shared_ptr<const bytecode> code) {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_entries[filename] = entry { stamp, std::move(code) };
+		}
+
+	public:
+		bytecode_cache() = default;
+
+		// also keeps compiled chunks in `directory`, so they survive the process
+		explicit bytecode_cache(std::filesystem::path directory) : m_directory(std::move(directory)) {
+			std::error_code ec;
+			std::filesystem::create_directories(m_directory, ec);
+		}
+
+		bytecode_cache(const bytecode_cache&) = delete;
+		bytecode_cache& operator=(const bytecode_cache&) = delete;
+
+		// routes the state's script_file, safe_script_file, load_file and require_file calls through this cache;
+		// the cache must outlive the state, or be uninstalled first
+		void install(lua_State* L) {
+			lua_pushlightuserdata(L, static_cast<detail::file_loader*>(this));
+			lua_setfield(L, LUA_REGISTRYINDEX, detail::default_file_loader_name());
+		}
+
+		static void uninstall(lua_State* L) {
+			lua_pushnil(L);
+			lua_setfield(L, LUA_REGISTRYINDEX, detail::default_file_loader_name());
+		}
+
+		int load_file(lua_State* L, const std::string& filename, load_mode mode) override {
+			file_stamp stamp;
+			if (mode != load_mode::any || !stamp_of(filename, stamp)) {
+				// a cached chunk is always binary, whatever the file holds, so only "bt" loads can be served from it;
+				// for the rest, or with nothing to key on, let Lua produce the usual result or error
+				return luaL_loadfilex(L, filename.c_str(), to_string(mode).c_str());
+			}
+
+			std::shared_ptr<const bytecode> code;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				auto it = m_entries.find(filename);
+				if (it != m_entries.end() && it->second.stamp == stamp) {
+					code = it->second.code;
+					++m_stats.hits;
+				}
+			}
+			if (code != nullptr && load_code(L, *code, filename) == LUA_OK) {
+				return LUA_OK;
+			}
+			if (code != nullptr) {
+				lua_pop(L, 1);
+			}
+
+			if (!m_directory.empty()) {
+				code = read_disk(filename, stamp);
+				if (code != nullptr) {
+					if (load_code(L, *code, filename) == LUA_OK) {
+						store(filename, stamp, std::move(code));
+						std::lock_guard<std::mutex> lock(m_mutex);
+						++m_stats.disk_hits;
+						return LUA_OK;
+					}
+					// written by an incompatible build: recompile and overwrite it below
+					lua_pop(L, 1);
+				}
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				++m_stats.misses;
+			}
+			int status = luaL_loadfilex(L, filename.c_str(), to_string(mode).c_str());
+			if (status != LUA_OK) {
+				return status;
+			}
+			auto compiled = std::make_shared<bytecode>();
+			if (lua_dump(L, bytecode_dump_writer, static_cast<void*>(compiled.get()), 0) != 0 || compiled->empty()) {
+				// still loaded fine, it just does not get cached
+				return LUA_OK;
+			}
+			if (!m_directory.empty()) {
+				write_disk(filename, stamp, *compiled);
+			}
+			store(filename, stamp, std::move(compiled));
+			return LUA_OK;
+		}
+
+		std::size_t size() {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return m_entries.size();
+		}
+
+		void clear() {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_entries.clear();
+		}
+
+		bytecode_cache_stats stats() {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return m_stats;
+		}
+	};
+
+} // namespace sol
+
+#endif // SOL_BYTECODE_CACHE_HPP
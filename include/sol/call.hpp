@@ -32,6 +32,10 @@
 #include <sol/stack.hpp>
 #include <sol/unique_usertype_traits.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
 namespace sol {
 	namespace u_detail {
 
@@ -135,14 +139,130 @@ namespace sol {
 		};
 
 		namespace overload_detail {
+			inline constexpr bool dispatch_enabled = SOL_IS_ON(SOL_OVERLOAD_DISPATCH_TABLE_I_);
+			inline constexpr std::size_t dispatch_argument_count = SOL_OVERLOAD_DISPATCH_ARGUMENTS_I_;
+			// none, and every lua_type result (LuaJIT's cdata included)
+			inline constexpr std::size_t dispatch_tag_count = 16;
+			inline constexpr std::uint64_t all_candidates = ~static_cast<std::uint64_t>(0);
+
+			constexpr bool dispatch_accepts(type expected, type actual) {
+				// conservative: a candidate is only ruled out
+				// when its checker can never accept that Lua type
+				if (expected == type::poly || expected == type::boolean || expected == actual || actual == type::none || actual == type::lua_nil) {
+					return true;
+				}
+				switch (expected) {
+				case type::number:
+					return SOL_IS_ON(SOL_STRINGS_ARE_NUMBERS_I_) && actual == type::string;
+				case type::string:
+					return actual == type::number;
+				case type::table:
+					return actual == type::userdata;
+				case type::function:
+					// callable tables and userdata
+					return actual == type::table || actual == type::userdata;
+				case type::userdata:
+					// containers from tables, void* from light userdata
+					return actual == type::table || actual == type::lightuserdata;
+				case type::lightuserdata:
+					return actual == type::userdata;
+				default:
+					return false;
+				}
+			}
+
+			template <typename Arg>
+			constexpr type dispatch_expected_type() {
+				using Tu = meta::unqualified_t<Arg>;
+				if constexpr (meta::meta_detail::is_adl_sol_lua_check_v<Tu> || lua_size_v<Tu> != 1) {
+					return type::poly;
+				}
+				else {
+					return lua_type_of_v<Tu>;
+				}
+			}
+
+			template <typename... Args>
+			constexpr std::array<type, dispatch_argument_count> dispatch_signature(types<Args...>) {
+				constexpr type expected[] = { type::poly, dispatch_expected_type<Args>()... };
+				std::array<type, dispatch_argument_count> signature {};
+				bool open_ended = false;
+				for (std::size_t i = 0; i < dispatch_argument_count; ++i) {
+					// once an argument can take any number of slots (or any type),
+					// nothing after it can be positioned statically
+					open_ended = open_ended || i >= sizeof...(Args) || expected[i + 1] == type::poly;
+					signature[i] = open_ended ? type::poly : expected[i + 1];
+				}
+				return signature;
+			}
+
+			template <typename... Fxs>
+			constexpr std::array<std::array<std::uint64_t, dispatch_tag_count>, dispatch_argument_count> make_dispatch_masks() {
+				constexpr std::array<type, dispatch_argument_count> signatures[]
+					= { dispatch_signature(typename lua_bind_traits<meta::unwrap_unqualified_t<Fxs>>::free_args_list())... };
+				std::array<std::array<std::uint64_t, dispatch_tag_count>, dispatch_argument_count> masks {};
+				for (std::size_t position = 0; position < dispatch_argument_count; ++position) {
+					for (std::size_t tag = 0; tag < dispatch_tag_count; ++tag) {
+						if (tag > static_cast<std::size_t>(LUA_TTHREAD) + 1) {
+							masks[position][tag] = all_candidates;
+							continue;
+						}
+						type actual = static_cast<type>(static_cast<int>(tag) - 1);
+						std::uint64_t mask = 0;
+						for (std::size_t fx = 0; fx < sizeof...(Fxs); ++fx) {
+							if (dispatch_accepts(signatures[fx][position], actual)) {
+								mask |= static_cast<std::uint64_t>(1) << fx;
+							}
+						}
+						masks[position][tag] = mask;
+					}
+				}
+				return masks;
+			}
+
+			template <typename... Fxs>
+			inline constexpr std::array<std::array<std::uint64_t, dispatch_tag_count>, dispatch_argument_count> dispatch_masks_v
+				= make_dispatch_masks<Fxs...>();
+
+			template <typename... Fxs>
+			inline std::uint64_t dispatch_candidates(lua_State* L, int fxarity, int start) {
+				if constexpr (!dispatch_enabled || sizeof...(Fxs) < 2 || sizeof...(Fxs) > 64) {
+					(void)L;
+					(void)fxarity;
+					(void)start;
+					return all_candidates;
+				}
+				else {
+					const auto& masks = dispatch_masks_v<Fxs...>;
+					std::uint64_t candidates = all_candidates;
+					int argument_count = (std::min)(fxarity, static_cast<int>(dispatch_argument_count));
+					for (int i = 0; i < argument_count; ++i) {
+						candidates &= masks[static_cast<std::size_t>(i)][static_cast<std::size_t>(lua_type(L, start + i) + 1)];
+					}
+					return candidates;
+				}
+			}
+
+			template <std::size_t I>
+			constexpr bool dispatch_allows(std::uint64_t candidates) {
+				if constexpr (!dispatch_enabled || I >= 64) {
+					(void)candidates;
+					return true;
+				}
+				else {
+					return ((candidates >> I) & 1) != 0;
+				}
+			}
+
 			template <std::size_t... M, typename Match, typename... Args>
-			inline int overload_match_arity(types<>, std::index_sequence<>, std::index_sequence<M...>, Match&&, lua_State* L, int, int, Args&&...) {
+			inline int overload_match_arity(
+			     types<>, std::index_sequence<>, std::index_sequence<M...>, Match&&, lua_State* L, int, int, std::uint64_t, Args&&...) {
 				return luaL_error(L, "sol: no matching function call takes this number of arguments and the specified types");
 			}
 
 			template <typename Fx, typename... Fxs, std::size_t I, std::size_t... In, std::size_t... M, typename Match, typename... Args>
 			inline int overload_match_arity(types<Fx, Fxs...>, std::index_sequence<I, In...>, std::index_sequence<M...>, Match&& matchfx, lua_State* L,
-			     int fxarity, int start, Args&&... args) {
+			     int fxarity, int start, std::uint64_t candidates, Args&&... args) {
 				typedef lua_bind_traits<meta::unwrap_unqualified_t<Fx>> traits;
 				typedef meta::tuple_types<typename traits::return_type> return_types;
 				typedef typename traits::free_args_list args_list;
@@ -156,6 +276,7 @@ namespace sol {
 					     L,
 					     fxarity,
 					     start,
+					     candidates,
 					     std::forward<Args>(args)...);
 				}
 				else {
@@ -168,11 +289,13 @@ namespace sol {
 							     L,
 							     fxarity,
 							     start,
+							     candidates,
 							     std::forward<Args>(args)...);
 						}
 					}
 					stack::record tracking {};
-					if (!stack::stack_detail::check_types(args_list(), L, start, &no_panic, tracking)) {
+					// candidates the dispatch table already ruled out skip the full check
+					if (!dispatch_allows<I>(candidates) || !stack::stack_detail::check_types(args_list(), L, start, &no_panic, tracking)) {
 						return overload_match_arity(types<Fxs...>(),
 						     std::index_sequence<In...>(),
 						     std::index_sequence<M...>(),
@@ -180,6 +303,7 @@ namespace sol {
 						     L,
 						     fxarity,
 						     start,
+						     candidates,
 						     std::forward<Args>(args)...);
 					}
 					return matchfx(types<Fx>(), meta::index_value<I>(), return_types(), args_list(), L, fxarity, start, std::forward<Args>(args)...);
@@ -188,7 +312,8 @@ namespace sol {
 
 			template <std::size_t... M, typename Match, typename... Args>
 			inline int overload_match_arity_single(
-			     types<>, std::index_sequence<>, std::index_sequence<M...>, Match&& matchfx, lua_State* L, int fxarity, int start, Args&&... args) {
+			     types<>, std::index_sequence<>, std::index_sequence<M...>, Match&& matchfx, lua_State* L, int fxarity, int start, std::uint64_t candidates,
+			     Args&&... args) {
 				return overload_match_arity(types<>(),
 				     std::index_sequence<>(),
 				     std::index_sequence<M...>(),
@@ -196,12 +321,14 @@ namespace sol {
 				     L,
 				     fxarity,
 				     start,
+				     candidates,
 				     std::forward<Args>(args)...);
 			}
 
 			template <typename Fx, std::size_t I, std::size_t... M, typename Match, typename... Args>
 			inline int overload_match_arity_single(
-			     types<Fx>, std::index_sequence<I>, std::index_sequence<M...>, Match&& matchfx, lua_State* L, int fxarity, int start, Args&&... args) {
+			     types<Fx>, std::index_sequence<I>, std::index_sequence<M...>, Match&& matchfx, lua_State* L, int fxarity, int start, std::uint64_t candidates,
+			     Args&&... args) {
 				typedef lua_bind_traits<meta::unwrap_unqualified_t<Fx>> traits;
 				typedef meta::tuple_types<typename traits::return_type> return_types;
 				typedef typename traits::free_args_list args_list;
@@ -215,6 +342,7 @@ namespace sol {
 					     L,
 					     fxarity,
 					     start,
+					     candidates,
 					     std::forward<Args>(args)...);
 				}
 				if constexpr (!traits::runtime_variadics_t::value) {
@@ -226,6 +354,7 @@ namespace sol {
 						     L,
 						     fxarity,
 						     start,
+						     candidates,
 						     std::forward<Args>(args)...);
 					}
 				}
@@ -235,7 +364,7 @@ namespace sol {
 			template <typename Fx, typename Fx1, typename... Fxs, std::size_t I, std::size_t I1, std::size_t... In, std::size_t... M, typename Match,
 			     typename... Args>
 			inline int overload_match_arity_single(types<Fx, Fx1, Fxs...>, std::index_sequence<I, I1, In...>, std::index_sequence<M...>, Match&& matchfx,
-			     lua_State* L, int fxarity, int start, Args&&... args) {
+			     lua_State* L, int fxarity, int start, std::uint64_t candidates, Args&&... args) {
 				typedef lua_bind_traits<meta::unwrap_unqualified_t<Fx>> traits;
 				typedef meta::tuple_types<typename traits::return_type> return_types;
 				typedef typename traits::free_args_list args_list;
@@ -249,6 +378,7 @@ namespace sol {
 					     L,
 					     fxarity,
 					     start,
+					     candidates,
 					     std::forward<Args>(args)...);
 				}
 				else {
@@ -261,11 +391,13 @@ namespace sol {
 							     L,
 							     fxarity,
 							     start,
+							     candidates,
 							     std::forward<Args>(args)...);
 						}
 					}
 					stack::record tracking {};
-					if (!stack::stack_detail::check_types(args_list(), L, start, &no_panic, tracking)) {
+					// candidates the dispatch table already ruled out skip the full check
+					if (!dispatch_allows<I>(candidates) || !stack::stack_detail::check_types(args_list(), L, start, &no_panic, tracking)) {
 						return overload_match_arity(types<Fx1, Fxs...>(),
 						     std::index_sequence<I1, In...>(),
 						     std::index_sequence<M...>(),
@@ -273,6 +405,7 @@ namespace sol {
 						     L,
 						     fxarity,
 						     start,
+						     candidates,
 						     std::forward<Args>(args)...);
 					}
 					return matchfx(types<Fx>(), meta::index_value<I>(), return_types(), args_list(), L, fxarity, start, std::forward<Args>(args)...);
@@ -289,6 +422,7 @@ namespace sol {
 			     L,
 			     fxarity,
 			     start,
+			     overload_detail::dispatch_candidates<Functions...>(L, fxarity, start),
 			     std::forward<Args>(args)...);
 		}
 
@@ -314,12 +448,14 @@ namespace sol {
 
 			T* obj = detail::usertype_allocate<T>(L);
 			reference userdataref(L, -1);
-			stack::stack_detail::undefined_metatable umf(L, &meta[0], &stack::stack_detail::set_undefined_methods_on<T>);
+			stack::stack_detail::undefined_metatable umf(L, stack::stack_detail::usertype_cache_key<T>(), &meta[0], &stack::stack_detail::set_undefined_methods_on<T>);
 			umf();
+			detail::usertype_construct_guard<T> guard(L, -1, obj);
 
 			// put userdata at the first index
 			lua_insert(L, 1);
 			construct_match<T, TypeLists...>(constructor_match<T, checked, clean_stack>(obj), L, argcount, 1 + static_cast<int>(syntax));
+			guard.release();
 
 			userdataref.push();
 			return 1;
@@ -648,12 +784,14 @@ namespace sol {
 
 				T* obj = detail::usertype_allocate<T>(L);
 				reference userdataref(L, -1);
-				stack::stack_detail::undefined_metatable umf(L, &meta[0], &stack::stack_detail::set_undefined_methods_on<T>);
+				stack::stack_detail::undefined_metatable umf(L, stack::stack_detail::usertype_cache_key<T>(), &meta[0], &stack::stack_detail::set_undefined_methods_on<T>);
 				umf();
+				detail::usertype_construct_guard<T> guard(L, -1, obj);
 
 				// put userdata at the first index
 				lua_insert(L, 1);
 				construct_match<T, Args...>(constructor_match<T, checked, clean_stack>(obj), L, argcount, boost + 1 + 1 + static_cast<int>(syntax));
+				guard.release();
 
 				userdataref.push();
 				return 1;
@@ -670,13 +808,15 @@ namespace sol {
 					const auto& meta = usertype_traits<T>::metatable();
 					T* obj = detail::usertype_allocate<T>(L);
 					reference userdataref(L, -1);
-					stack::stack_detail::undefined_metatable umf(L, &meta[0], &stack::stack_detail::set_undefined_methods_on<T>);
+					stack::stack_detail::undefined_metatable umf(L, stack::stack_detail::usertype_cache_key<T>(), &meta[0], &stack::stack_detail::set_undefined_methods_on<T>);
 					umf();
+					detail::usertype_construct_guard<T> guard(L, -1, obj);
 
 					auto& func = std::get<I>(f.functions);
 					// put userdata at the first index
 					lua_insert(L, 1);
 					stack::call_into_lua<checked, clean_stack>(r, a, L, boost + 1 + start, func, detail::implicit_wrapper<T>(obj));
+					guard.release();
 
 					userdataref.push();
 					return 1;
@@ -702,7 +842,20 @@ namespace sol {
 				else {
 					using uFx = meta::unqualified_t<Fx>;
 					lua_call_wrapper<T, uFx, is_index, is_variable, checked, boost, clean_stack> lcw {};
-					return lcw.call(L, std::forward<F>(f).fx);
+					if constexpr (is_usertype_pooled_v<T>) {
+						// the custom destructor ends the object's lifetime, but the slot still goes back to the pool
+						T* data = *static_cast<T**>(detail::align_usertype_pointer(lua_touserdata(L, 1)));
+						if (data == nullptr) {
+							// never got a slot, or constructing into it failed
+							return 0;
+						}
+						int r = lcw.call(L, std::forward<F>(f).fx);
+						usertype_allocation_policy<T>::deallocate(static_cast<void*>(data));
+						return r;
+					}
+					else {
+						return lcw.call(L, std::forward<F>(f).fx);
+					}
 				}
 			}
 		};
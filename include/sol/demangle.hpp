@@ -47,96 +47,128 @@ namespace sol { namespace detail {
 		"`anonymous namespace'" } };
 
 
+	inline constexpr std::array<string_view, 10> short_demangle_ops { { "operator<",
+		"operator<<",
+		"operator<<=",
+		"operator<=",
+		"operator>",
+		"operator>>",
+		"operator>>=",
+		"operator>=",
+		"operator->",
+		"operator->*" } };
+
+	// names are cut out of the compiler's signature for a function template,
+	// entirely at compile time: nothing is parsed (or allocated) at run time
+	template <std::size_t N>
+	struct ctti_name_buffer {
+		char data[N] {};
+		std::size_t size = 0;
+
+		constexpr string_view view() const {
+			return string_view(data, size);
+		}
+	};
+
+	constexpr bool ctti_is_blank(char c) {
+		return c == ' ' || c == '\t';
+	}
+
+	constexpr string_view ctti_trim(string_view name) {
+		while (!name.empty() && ctti_is_blank(name.front()))
+			name.remove_prefix(1);
+		while (!name.empty() && ctti_is_blank(name.back()))
+			name.remove_suffix(1);
+		return name;
+	}
+
 #if SOL_IS_ON(SOL_COMPILER_GCC_I_) || SOL_IS_ON(SOL_COMPILER_CLANG_I_) || SOL_IS_ON(SOL_COMPILER_VCXX_CLANG_I_)
-	inline std::string ctti_get_type_name_from_sig(std::string name) {
+	template <typename T, class seperator_mark = int>
+	constexpr string_view ctti_get_type_signature() {
+		return string_view(__PRETTY_FUNCTION__);
+	}
+
+	constexpr string_view ctti_type_name_from_sig(string_view name) {
 		// cardinal sins from MINGW
-		using namespace std;
 		std::size_t start = name.find_first_of('[');
 		start = name.find_first_of('=', start);
 		std::size_t end = name.find_last_of(']');
-		if (end == std::string::npos)
+		if (end == string_view::npos)
 			end = name.size();
-		if (start == std::string::npos)
+		if (start == string_view::npos)
 			start = 0;
 		if (start < name.size() - 1)
 			start += 1;
 		name = name.substr(start, end - start);
 		start = name.rfind("seperator_mark");
-		if (start != std::string::npos) {
-			name.erase(start - 2, name.length());
+		if (start != string_view::npos) {
+			name = name.substr(0, start - 2);
 		}
-		while (!name.empty() && isblank(name.front()))
-			name.erase(name.begin());
-		while (!name.empty() && isblank(name.back()))
-			name.pop_back();
-
-		for (std::size_t r = 0; r < removals.size(); ++r) {
-			auto found = name.find(removals[r]);
-			while (found != std::string::npos) {
-				name.erase(found, removals[r].size());
-				found = name.find(removals[r]);
-			}
-		}
-
-		return name;
-	}
-
-	template <typename T, class seperator_mark = int>
-	inline std::string ctti_get_type_name() {
-		return ctti_get_type_name_from_sig(__PRETTY_FUNCTION__);
+		return ctti_trim(name);
 	}
 #elif SOL_IS_ON(SOL_COMPILER_VCXX_I_)
-	inline std::string ctti_get_type_name_from_sig(std::string name) {
-		std::size_t start = name.find("get_type_name");
-		if (start == std::string::npos)
+	template <typename T>
+	constexpr string_view ctti_get_type_signature() {
+		return string_view(__FUNCSIG__);
+	}
+
+	constexpr string_view ctti_type_name_from_sig(string_view name) {
+		constexpr string_view marker = "ctti_get_type_signature";
+		std::size_t start = name.find(marker);
+		if (start == string_view::npos)
 			start = 0;
 		else
-			start += 13;
+			start += marker.size();
 		if (start < name.size() - 1)
 			start += 1;
 		std::size_t end = name.find_last_of('>');
-		if (end == std::string::npos)
+		if (end == string_view::npos)
 			end = name.size();
 		name = name.substr(start, end - start);
-		if (name.find("struct", 0) == 0)
-			name.replace(0, 6, "", 0);
-		if (name.find("class", 0) == 0)
-			name.replace(0, 5, "", 0);
-		while (!name.empty() && isblank(name.front()))
-			name.erase(name.begin());
-		while (!name.empty() && isblank(name.back()))
-			name.pop_back();
-
-		for (std::size_t r = 0; r < removals.size(); ++r) {
-			auto found = name.find(removals[r]);
-			while (found != std::string::npos) {
-				name.erase(found, removals[r].size());
-				found = name.find(removals[r]);
-			}
-		}
-
-		return name;
-	}
-
-	template <typename T>
-	std::string ctti_get_type_name() {
-		return ctti_get_type_name_from_sig(__FUNCSIG__);
+		if (name.substr(0, 6) == "struct")
+			name.remove_prefix(6);
+		if (name.substr(0, 5) == "class")
+			name.remove_prefix(5);
+		return ctti_trim(name);
 	}
 #else
 #error Compiler not supported for demangling
 #endif // compilers
 
-	template <typename T>
-	std::string demangle_once() {
-		std::string realname = ctti_get_type_name<T>();
-		return realname;
+	// copies name into out without any of the removals, returning the new size;
+	// with out == nullptr, it only counts
+	constexpr std::size_t ctti_clean_type_name(string_view name, char* out) {
+		std::size_t size = 0;
+		for (std::size_t i = 0; i < name.size();) {
+			bool removed = false;
+			for (const string_view& removal : removals) {
+				if (name.compare(i, removal.size(), removal) == 0) {
+					i += removal.size();
+					removed = true;
+					break;
+				}
+			}
+			if (removed) {
+				continue;
+			}
+			if (out != nullptr) {
+				out[size] = name[i];
+			}
+			++size;
+			++i;
+		}
+		return size;
 	}
 
-	inline std::string short_demangle_from_type_name(std::string realname) {
+	template <std::size_t N>
+	constexpr ctti_name_buffer<N> ctti_make_type_name(string_view name) {
+		ctti_name_buffer<N> buffer {};
+		buffer.size = ctti_clean_type_name(name, buffer.data);
+		return buffer;
+	}
+
+	constexpr string_view ctti_short_type_name(string_view realname) {
 		// This isn't the most complete but it'll do for now...?
-		static const std::array<std::string, 10> ops = {
-			{ "operator<", "operator<<", "operator<<=", "operator<=", "operator>", "operator>>", "operator>>=", "operator>=", "operator->", "operator->*" }
-		};
 		int level = 0;
 		std::size_t idx = 0;
 		for (idx = static_cast<std::size_t>(realname.empty() ? 0 : realname.size() - 1); idx > 0; --idx) {
@@ -148,9 +180,9 @@ namespace sol { namespace detail {
 			if (!isleft && !isright)
 				continue;
 			bool earlybreak = false;
-			for (const auto& op : ops) {
+			for (const string_view& op : short_demangle_ops) {
 				std::size_t nisop = realname.rfind(op, idx);
-				if (nisop == std::string::npos)
+				if (nisop == string_view::npos)
 					continue;
 				std::size_t nisopidx = idx - op.size() + 1;
 				if (nisop == nisopidx) {
@@ -165,26 +197,47 @@ namespace sol { namespace detail {
 			level += isleft ? -1 : 1;
 		}
 		if (idx > 0) {
-			realname.erase(0, realname.length() < static_cast<std::size_t>(idx) ? realname.length() : idx + 1);
+			realname.remove_prefix(realname.length() < static_cast<std::size_t>(idx) ? realname.length() : idx + 1);
 		}
 		return realname;
 	}
 
 	template <typename T>
-	std::string short_demangle_once() {
-		std::string realname = ctti_get_type_name<T>();
-		return short_demangle_from_type_name(realname);
+	struct ctti_type_name {
+		static constexpr string_view signature = ctti_get_type_signature<T>();
+		static constexpr string_view raw_name = ctti_type_name_from_sig(signature);
+		static constexpr ctti_name_buffer<ctti_clean_type_name(raw_name, nullptr) + 1> name = ctti_make_type_name<ctti_clean_type_name(raw_name, nullptr) + 1>(raw_name);
+	};
+
+	// both views are null-terminated, and live as long as the program does
+	template <typename T>
+	constexpr string_view demangle_view() {
+		return ctti_type_name<T>::name.view();
+	}
+
+	template <typename T>
+	constexpr string_view short_demangle_view() {
+		return ctti_short_type_name(demangle_view<T>());
+	}
+
+	template <typename T>
+	std::string ctti_get_type_name() {
+		return std::string(demangle_view<T>());
+	}
+
+	inline std::string short_demangle_from_type_name(std::string realname) {
+		return std::string(ctti_short_type_name(realname));
 	}
 
 	template <typename T>
 	const std::string& demangle() {
-		static const std::string d = demangle_once<T>();
+		static const std::string d(demangle_view<T>());
 		return d;
 	}
 
 	template <typename T>
 	const std::string& short_demangle() {
-		static const std::string d = short_demangle_once<T>();
+		static const std::string d(short_demangle_view<T>());
 		return d;
 	}
 }} // namespace sol::detail
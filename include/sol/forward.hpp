@@ -189,6 +189,13 @@ namespace sol {
 	template <typename T>
 	struct nested;
 	template <typename T>
+	class array_view;
+	template <typename Signature>
+	class lua_callback;
+	class key_path;
+	template <typename T>
+	class table_schema;
+	template <typename T>
 	struct light;
 	template <typename T>
 	struct user;
@@ -203,6 +210,8 @@ namespace sol {
 	struct usertype_traits;
 	template <typename T>
 	struct unique_usertype_traits;
+	template <typename T>
+	struct usertype_allocation_policy;
 
 	template <typename... Args>
 	struct types {
@@ -28,6 +28,7 @@
 #include <sol/unsafe_function.hpp>
 #include <sol/protected_function.hpp>
 #include <sol/bytecode.hpp>
+#include <sol/lua_callback.hpp>
 #include <functional>
 
 namespace sol {
@@ -76,54 +77,16 @@ namespace sol {
 		return *this;
 	}
 
-	namespace detail {
-		template <typename... R>
-		struct std_shim {
-			unsafe_function lua_func_;
-
-			std_shim(unsafe_function lua_func) : lua_func_(std::move(lua_func)) {
-			}
-
-			template <typename... Args>
-			meta::return_type_t<R...> operator()(Args&&... args) {
-				return lua_func_.call<R...>(std::forward<Args>(args)...);
-			}
-		};
-
-		template <>
-		struct std_shim<void> {
-			unsafe_function lua_func_;
-
-			std_shim(unsafe_function lua_func) : lua_func_(std::move(lua_func)) {
-			}
-
-			template <typename... Args>
-			void operator()(Args&&... args) {
-				lua_func_.call<void>(std::forward<Args>(args)...);
-			}
-		};
-	} // namespace detail
-
 	namespace stack {
 		template <typename Signature>
 		struct unqualified_getter<std::function<Signature>> {
-			typedef meta::bind_traits<Signature> fx_t;
-			typedef typename fx_t::args_list args_lists;
-			typedef meta::tuple_types<typename fx_t::return_type> return_types;
-
-			template <typename... R>
-			static std::function<Signature> get_std_func(types<R...>, lua_State* L, int index) {
-				detail::std_shim<R...> fx(unsafe_function(L, index));
-				return fx;
-			}
-
 			static std::function<Signature> get(lua_State* L, int index, record& tracking) {
 				tracking.use(1);
 				type t = type_of(L, index);
 				if (t == type::none || t == type::lua_nil) {
 					return nullptr;
 				}
-				return get_std_func(return_types(), L, index);
+				return lua_callback<Signature>(L, index);
 			}
 		};
 
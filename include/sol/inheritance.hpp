@@ -62,61 +62,74 @@ namespace sol {
 			return key;
 		}
 
+		inline bool type_id_equals(std::uint64_t left_id, const string_view& left, std::uint64_t right_id, const string_view& right) {
+			// differing ids are never the same type; equal ids are confirmed
+			// by name, which is free when both come from the same static storage
+			return left_id == right_id && (left.data() == right.data() || left == right);
+		}
+
+		template <typename T>
+		inline bool is_type_id(std::uint64_t ti_id, const string_view& ti) {
+			return type_id_equals(ti_id, ti, usertype_traits<T>::type_id(), usertype_traits<T>::qualified_name());
+		}
+
 		template <typename T>
 		struct inheritance {
 			typedef typename base<T>::type bases_t;
 
-			static bool type_check_bases(types<>, const string_view&) {
+			// sol::bases<...> has to list every ancestor, not just the direct ones, so there is
+			// no hierarchy to walk: a check or cast is one integer compare per listed base,
+			// unrolled at compile time. a per-(derived, target) cache of resolved casts would
+			// need a hash lookup on every call, which costs more than the handful of compares it skips
+			static bool type_check_bases(types<>, std::uint64_t, const string_view&) {
 				return false;
 			}
 
 			template <typename Base, typename... Args>
-			static bool type_check_bases(types<Base, Args...>, const string_view& ti) {
-				return ti == usertype_traits<Base>::qualified_name() || type_check_bases(types<Args...>(), ti);
+			static bool type_check_bases(types<Base, Args...>, std::uint64_t ti_id, const string_view& ti) {
+				return is_type_id<Base>(ti_id, ti) || type_check_bases(types<Args...>(), ti_id, ti);
 			}
 
-			static bool type_check(const string_view& ti) {
-				return ti == usertype_traits<T>::qualified_name() || type_check_bases(bases_t(), ti);
+			static bool type_check(std::uint64_t ti_id, const string_view& ti) {
+				return is_type_id<T>(ti_id, ti) || type_check_bases(bases_t(), ti_id, ti);
 			}
 
 			template <typename... Bases>
-			static bool type_check_with(const string_view& ti) {
-				return ti == usertype_traits<T>::qualified_name() || type_check_bases(types<Bases...>(), ti);
+			static bool type_check_with(std::uint64_t ti_id, const string_view& ti) {
+				return is_type_id<T>(ti_id, ti) || type_check_bases(types<Bases...>(), ti_id, ti);
 			}
 
-			static void* type_cast_bases(types<>, T*, const string_view&) {
+			static void* type_cast_bases(types<>, T*, std::uint64_t, const string_view&) {
 				return nullptr;
 			}
 
 			template <typename Base, typename... Args>
-			static void* type_cast_bases(types<Base, Args...>, T* data, const string_view& ti) {
+			static void* type_cast_bases(types<Base, Args...>, T* data, std::uint64_t ti_id, const string_view& ti) {
 				// Make sure to convert to T first, and then dynamic cast to the proper type
-				return ti != usertype_traits<Base>::qualified_name() ? type_cast_bases(types<Args...>(), data, ti)
-				                                                     : static_cast<void*>(static_cast<Base*>(data));
+				return !is_type_id<Base>(ti_id, ti) ? type_cast_bases(types<Args...>(), data, ti_id, ti) : static_cast<void*>(static_cast<Base*>(data));
 			}
 
-			static void* type_cast(void* voiddata, const string_view& ti) {
+			static void* type_cast(void* voiddata, std::uint64_t ti_id, const string_view& ti) {
 				T* data = static_cast<T*>(voiddata);
-				return static_cast<void*>(ti != usertype_traits<T>::qualified_name() ? type_cast_bases(bases_t(), data, ti) : data);
+				return static_cast<void*>(!is_type_id<T>(ti_id, ti) ? type_cast_bases(bases_t(), data, ti_id, ti) : data);
 			}
 
 			template <typename... Bases>
-			static void* type_cast_with(void* voiddata, const string_view& ti) {
+			static void* type_cast_with(void* voiddata, std::uint64_t ti_id, const string_view& ti) {
 				T* data = static_cast<T*>(voiddata);
-				return static_cast<void*>(ti != usertype_traits<T>::qualified_name() ? type_cast_bases(types<Bases...>(), data, ti) : data);
+				return static_cast<void*>(!is_type_id<T>(ti_id, ti) ? type_cast_bases(types<Bases...>(), data, ti_id, ti) : data);
 			}
 
 			template <typename U>
-			static bool type_unique_cast_bases(types<>, void*, void*, const string_view&) {
+			static bool type_unique_cast_bases(types<>, void*, void*, std::uint64_t, const string_view&) {
 				return 0;
 			}
 
 			template <typename U, typename Base, typename... Args>
-			static int type_unique_cast_bases(types<Base, Args...>, void* source_data, void* target_data, const string_view& ti) {
+			static int type_unique_cast_bases(types<Base, Args...>, void* source_data, void* target_data, std::uint64_t ti_id, const string_view& ti) {
 				using uu_traits = unique_usertype_traits<U>;
 				using base_ptr = typename uu_traits::template rebind_actual_type<Base>;
-				string_view base_ti = usertype_traits<Base>::qualified_name();
-				if (base_ti == ti) {
+				if (is_type_id<Base>(ti_id, ti)) {
 					if (target_data != nullptr) {
 						U* source = static_cast<U*>(source_data);
 						base_ptr* target = static_cast<base_ptr*>(target_data);
@@ -125,63 +138,61 @@ namespace sol {
 					}
 					return 2;
 				}
-				return type_unique_cast_bases<U>(types<Args...>(), source_data, target_data, ti);
+				return type_unique_cast_bases<U>(types<Args...>(), source_data, target_data, ti_id, ti);
 			}
 
 			template <typename U>
-			static int type_unique_cast(void* source_data, void* target_data, const string_view& ti, const string_view& rebind_ti) {
+			static int type_unique_cast(void* source_data, void* target_data, std::uint64_t ti_id, const string_view& ti, std::uint64_t rebind_ti_id,
+				const string_view& rebind_ti) {
 				if constexpr (is_actual_type_rebindable_for_v<U>) {
 					using rebound_actual_type = unique_usertype_rebind_actual_t<U>;
 					using maybe_bases_or_empty = meta::conditional_t<std::is_void_v<rebound_actual_type>, types<>, bases_t>;
-					string_view this_rebind_ti = usertype_traits<rebound_actual_type>::qualified_name();
-					if (rebind_ti != this_rebind_ti) {
+					if (!is_type_id<rebound_actual_type>(rebind_ti_id, rebind_ti)) {
 						// this is not even of the same unique type
 						return 0;
 					}
-					string_view this_ti = usertype_traits<T>::qualified_name();
-					if (ti == this_ti) {
+					if (is_type_id<T>(ti_id, ti)) {
 						// direct match, return 1
 						return 1;
 					}
-					return type_unique_cast_bases<U>(maybe_bases_or_empty(), source_data, target_data, ti);
+					return type_unique_cast_bases<U>(maybe_bases_or_empty(), source_data, target_data, ti_id, ti);
 				}
 				else {
+					(void)rebind_ti_id;
 					(void)rebind_ti;
-					string_view this_ti = usertype_traits<T>::qualified_name();
-					if (ti == this_ti) {
+					if (is_type_id<T>(ti_id, ti)) {
 						// direct match, return 1
 						return 1;
 					}
-					return type_unique_cast_bases<U>(types<>(), source_data, target_data, ti);
+					return type_unique_cast_bases<U>(types<>(), source_data, target_data, ti_id, ti);
 				}
 			}
 
 			template <typename U, typename... Bases>
-			static int type_unique_cast_with(void* source_data, void* target_data, const string_view& ti, const string_view& rebind_ti) {
+			static int type_unique_cast_with(void* source_data, void* target_data, std::uint64_t ti_id, const string_view& ti, std::uint64_t rebind_ti_id,
+				const string_view& rebind_ti) {
 				using uc_bases_t = types<Bases...>;
 				if constexpr (is_actual_type_rebindable_for_v<U>) {
 					using rebound_actual_type = unique_usertype_rebind_actual_t<U>;
 					using cond_bases_t = meta::conditional_t<std::is_void_v<rebound_actual_type>, types<>, uc_bases_t>;
-					string_view this_rebind_ti = usertype_traits<rebound_actual_type>::qualified_name();
-					if (rebind_ti != this_rebind_ti) {
+					if (!is_type_id<rebound_actual_type>(rebind_ti_id, rebind_ti)) {
 						// this is not even of the same unique type
 						return 0;
 					}
-					string_view this_ti = usertype_traits<T>::qualified_name();
-					if (ti == this_ti) {
+					if (is_type_id<T>(ti_id, ti)) {
 						// direct match, return 1
 						return 1;
 					}
-					return type_unique_cast_bases<U>(cond_bases_t(), source_data, target_data, ti);
+					return type_unique_cast_bases<U>(cond_bases_t(), source_data, target_data, ti_id, ti);
 				}
 				else {
+					(void)rebind_ti_id;
 					(void)rebind_ti;
-					string_view this_ti = usertype_traits<T>::qualified_name();
-					if (ti == this_ti) {
+					if (is_type_id<T>(ti_id, ti)) {
 						// direct match, return 1
 						return 1;
 					}
-					return type_unique_cast_bases<U>(types<>(), source_data, target_data, ti);
+					return type_unique_cast_bases<U>(types<>(), source_data, target_data, ti_id, ti);
 				}
 			}
 		};
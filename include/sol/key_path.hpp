@@ -0,0 +1,234 @@
+// sol3
+
+// The MIT License (MIT)
+
+// Copyright (c) 2013-2020 Rapptz, ThePhD and contributors
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SOL_KEY_PATH_HPP
+#define SOL_KEY_PATH_HPP
+
+#include <sol/stack.hpp>
+#include <sol/reference.hpp>
+
+#include <vector>
+#include <utility>
+
+namespace sol {
+
+	// a sequence of keys pushed once and kept in the registry, so walking
+	// the same nested path through many tables costs only a lua_rawgeti per key
+	class key_path {
+	private:
+		lua_State* m_L = nullptr;
+		std::vector<stateless_reference> m_keys;
+
+		template <typename Key>
+		void add_key(lua_State* L, Key&& key) {
+			stack::push(L, std::forward<Key>(key));
+			m_keys.emplace_back(L, -1);
+			lua_pop(L, 1);
+		}
+
+		void release() noexcept {
+			for (stateless_reference& key : m_keys) {
+				key.deref(m_L);
+			}
+			m_keys.clear();
+		}
+
+	public:
+		key_path() noexcept = default;
+
+		template <typename Key, typename... Keys>
+		key_path(lua_State* L, Key&& key, Keys&&... keys) : m_L(main_thread(L, L)) {
+			m_keys.reserve(1 + sizeof...(Keys));
+			add_key(L, std::forward<Key>(key));
+			(add_key(L, std::forward<Keys>(keys)), ...);
+		}
+
+		key_path(const key_path& other) : m_L(other.m_L) {
+			m_keys.reserve(other.m_keys.size());
+			for (const stateless_reference& key : other.m_keys) {
+				m_keys.emplace_back(m_L, ref_index(key.registry_index()));
+			}
+		}
+
+		key_path(key_path&& other) noexcept : m_L(std::exchange(other.m_L, nullptr)), m_keys(std::move(other.m_keys)) {
+			other.m_keys.clear();
+		}
+
+		key_path& operator=(const key_path& other) {
+			if (this != &other) {
+				key_path copy(other);
+				*this = std::move(copy);
+			}
+			return *this;
+		}
+
+		key_path& operator=(key_path&& other) noexcept {
+			if (this != &other) {
+				release();
+				m_L = std::exchange(other.m_L, nullptr);
+				m_keys = std::move(other.m_keys);
+				other.m_keys.clear();
+			}
+			return *this;
+		}
+
+		~key_path() {
+			release();
+		}
+
+		lua_State* lua_state() const noexcept {
+			return m_L;
+		}
+
+		std::size_t size() const noexcept {
+			return m_keys.size();
+		}
+
+		bool empty() const noexcept {
+			return m_keys.empty();
+		}
+
+		int push_key(lua_State* L, std::size_t i) const noexcept {
+			return m_keys[i].push(L);
+		}
+
+		void check_state(lua_State* L) const {
+#if SOL_IS_ON(SOL_SAFE_REFERENCES_I_)
+			// the keys are registry slots of the state that built this path
+			if (main_thread(L, L) != m_L) {
+				luaL_error(L, "sol: a key_path was used with a lua_State other than the one it was created in");
+			}
+#else
+			(void)L;
+#endif
+		}
+	};
+
+	namespace stack {
+		namespace stack_detail {
+			template <bool raw>
+			inline void key_path_get(lua_State* L, int tableindex) {
+				if constexpr (raw) {
+					lua_rawget(L, tableindex);
+				}
+				else {
+					lua_gettable(L, tableindex);
+				}
+			}
+		} // namespace stack_detail
+
+		template <bool global, bool raw, typename C>
+		struct field_getter<key_path, global, raw, C> {
+			void get(lua_State* L, const key_path& path, int tableindex = -1) {
+				if (path.empty()) {
+					lua_pushnil(L);
+					return;
+				}
+				path.check_state(L);
+#if SOL_IS_ON(SOL_SAFE_STACK_CHECK_I_)
+				luaL_checkstack(L, static_cast<int>(path.size()) + 1, detail::not_enough_stack_space_generic);
+#endif // make sure stack doesn't overflow
+				int target = lua_absindex(L, tableindex);
+				const int first = lua_gettop(L) + 1;
+				for (std::size_t i = 0; i < path.size(); ++i) {
+					path.push_key(L, i);
+					stack_detail::key_path_get<raw>(L, target);
+					target = lua_gettop(L);
+					if (i + 1 < path.size() && !maybe_indexable(L, target)) {
+						// nothing further down to walk into
+						lua_pushnil(L);
+						break;
+					}
+				}
+				// only the value at the end of the path stays
+				if (lua_gettop(L) != first) {
+					lua_replace(L, first);
+					lua_settop(L, first);
+				}
+			}
+		};
+
+		template <typename P, bool global, bool raw, typename C>
+		struct probe_field_getter<key_path, P, global, raw, C> {
+			probe get(lua_State* L, const key_path& path, int tableindex = -1) {
+				if (!maybe_indexable(L, tableindex)) {
+					return probe(false, 0);
+				}
+				if (path.empty()) {
+					lua_pushnil(L);
+					return probe(false, 1);
+				}
+				path.check_state(L);
+#if SOL_IS_ON(SOL_SAFE_STACK_CHECK_I_)
+				luaL_checkstack(L, static_cast<int>(path.size()) + 1, detail::not_enough_stack_space_generic);
+#endif // make sure stack doesn't overflow
+				int target = lua_absindex(L, tableindex);
+				int levels = 0;
+				for (std::size_t i = 0; i < path.size(); ++i) {
+					path.push_key(L, i);
+					stack_detail::key_path_get<raw>(L, target);
+					++levels;
+					if (i + 1 < path.size() && !maybe_indexable(L)) {
+						return probe(false, levels);
+					}
+					target = lua_gettop(L);
+				}
+				return probe(check<P>(L), levels);
+			}
+		};
+
+		template <bool global, bool raw, typename C>
+		struct field_setter<key_path, global, raw, C> {
+			template <typename Value>
+			void set(lua_State* L, const key_path& path, Value&& value, int tableindex = -1) {
+				if (path.empty()) {
+					return;
+				}
+				path.check_state(L);
+#if SOL_IS_ON(SOL_SAFE_STACK_CHECK_I_)
+				luaL_checkstack(L, static_cast<int>(path.size()) + 1, detail::not_enough_stack_space_generic);
+#endif // make sure stack doesn't overflow
+				int target = lua_absindex(L, tableindex);
+				const int top = lua_gettop(L);
+				const std::size_t last = path.size() - 1;
+				for (std::size_t i = 0; i < last; ++i) {
+					path.push_key(L, i);
+					stack_detail::key_path_get<raw>(L, target);
+					target = lua_gettop(L);
+				}
+				path.push_key(L, last);
+				stack::push(L, std::forward<Value>(value));
+				if constexpr (raw) {
+					lua_rawset(L, target);
+				}
+				else {
+					lua_settable(L, target);
+				}
+				lua_settop(L, top);
+			}
+		};
+	} // namespace stack
+
+} // namespace sol
+
+#endif // SOL_KEY_PATH_HPP
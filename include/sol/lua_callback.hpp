@@ -0,0 +1,110 @@
+// sol3
+
+// The MIT License (MIT)
+
+// Copyright (c) 2013-2020 Rapptz, ThePhD and contributors
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SOL_LUA_CALLBACK_HPP
+#define SOL_LUA_CALLBACK_HPP
+
+#include <sol/stack.hpp>
+#include <sol/reference.hpp>
+
+#include <utility>
+
+namespace sol {
+
+	// a Lua function held by a single registry reference and called with a fixed signature:
+	// the argument pushes, return count and result conversion are all decided at compile time
+	template <typename R, typename... Args>
+	class lua_callback<R(Args...)> {
+	private:
+		reference m_ref;
+
+	public:
+		typedef R result_type;
+
+		lua_callback() noexcept = default;
+		lua_callback(lua_nil_t) noexcept : m_ref() {
+		}
+		lua_callback(lua_State* L, int index) : m_ref(L, index) {
+		}
+		lua_callback(const lua_callback&) = default;
+		lua_callback(lua_callback&&) noexcept = default;
+		lua_callback& operator=(const lua_callback&) = default;
+		lua_callback& operator=(lua_callback&&) noexcept = default;
+
+		lua_State* lua_state() const noexcept {
+			return m_ref.lua_state();
+		}
+
+		bool valid() const noexcept {
+			return m_ref.valid();
+		}
+
+		explicit operator bool() const noexcept {
+			return valid();
+		}
+
+		int push(lua_State* L) const noexcept {
+			return m_ref.push(L);
+		}
+
+		R operator()(Args... args) const {
+			lua_State* L = m_ref.lua_state();
+			m_ref.push(L);
+			int pushcount = stack::multi_push_reference(L, std::forward<Args>(args)...);
+			if constexpr (std::is_void_v<R>) {
+				lua_call(L, pushcount, 0);
+			}
+			else {
+				lua_call(L, pushcount, static_cast<int>(lua_size<R>::value));
+				return stack::pop<R>(L);
+			}
+		}
+	};
+
+	namespace stack {
+		template <typename Signature>
+		struct unqualified_getter<lua_callback<Signature>> {
+			static lua_callback<Signature> get(lua_State* L, int index, record& tracking) {
+				tracking.use(1);
+				type t = type_of(L, index);
+				if (t == type::none || t == type::lua_nil) {
+					return lua_nil;
+				}
+				return lua_callback<Signature>(L, index);
+			}
+		};
+
+		template <typename Signature>
+		struct unqualified_pusher<lua_callback<Signature>> {
+			static int push(lua_State* L, const lua_callback<Signature>& fx) {
+				if (fx) {
+					return fx.push(L);
+				}
+				return stack::push(L, lua_nil);
+			}
+		};
+	} // namespace stack
+
+} // namespace sol
+
+#endif // SOL_LUA_CALLBACK_HPP
@@ -0,0 +1,290 @@
+// sol3
+
+// The MIT License (MIT)
+
+// Copyright (c) 2013-2020 Rapptz, ThePhD and contributors
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SOL_MAPPED_FILE_HPP
+#define SOL_MAPPED_FILE_HPP
+
+#include <sol/stack.hpp>
+#include <sol/load_result.hpp>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#if SOL_IS_ON(SOL_PLATFORM_WINDOWS_I_)
+// keep windows.h's min/max macros and rarely used headers out of every file that includes sol,
+// without overriding whatever the user already chose
+#ifndef NOMINMAX
+#define NOMINMAX
+#define SOL_MAPPED_FILE_NOMINMAX_I_
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#define SOL_MAPPED_FILE_WIN32_LEAN_AND_MEAN_I_
+#endif
+#include <windows.h>
+#ifdef SOL_MAPPED_FILE_NOMINMAX_I_
+#undef NOMINMAX
+#undef SOL_MAPPED_FILE_NOMINMAX_I_
+#endif
+#ifdef SOL_MAPPED_FILE_WIN32_LEAN_AND_MEAN_I_
+#undef WIN32_LEAN_AND_MEAN
+#undef SOL_MAPPED_FILE_WIN32_LEAN_AND_MEAN_I_
+#endif
+#elif SOL_IS_ON(SOL_PLATFORM_UNIXLIKE_I_)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#include <vector>
+#endif
+
+namespace sol {
+
+	// a read-only view of a whole file, mapped into memory where the platform allows it;
+	// works for source and for bytecode, and hands out the same as_string_view() as basic_bytecode
+	class mapped_file {
+	private:
+		const char* m_data;
+		std::size_t m_size;
+		int m_error;
+#if SOL_IS_ON(SOL_PLATFORM_WINDOWS_I_)
+		HANDLE m_mapping;
+#elif SOL_IS_OFF(SOL_PLATFORM_UNIXLIKE_I_)
+		std::vector<char> m_contents;
+#endif
+
+		void unmap() noexcept {
+#if SOL_IS_ON(SOL_PLATFORM_WINDOWS_I_)
+			if (m_mapping != nullptr) {
+				UnmapViewOfFile(m_data);
+				CloseHandle(m_mapping);
+				m_mapping = nullptr;
+			}
+#elif SOL_IS_ON(SOL_PLATFORM_UNIXLIKE_I_)
+			if (m_size != 0) {
+				munmap(const_cast<char*>(m_data), m_size);
+			}
+#else
+			m_contents.clear();
+#endif
+			m_data = nullptr;
+			m_size = 0;
+		}
+
+	public:
+		mapped_file() noexcept
+		: m_data(nullptr)
+		, m_size(0)
+		, m_error(0)
+#if SOL_IS_ON(SOL_PLATFORM_WINDOWS_I_)
+		, m_mapping(nullptr)
+#endif
+		{
+		}
+
+		explicit mapped_file(const std::string& filename) : mapped_file() {
+			// empty files cannot be mapped, so they are represented by an empty string instead
+			static const char empty[1] = "";
+#if SOL_IS_ON(SOL_PLATFORM_WINDOWS_I_)
+			HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+			if (file == INVALID_HANDLE_VALUE) {
+				m_error = ENOENT;
+				return;
+			}
+			LARGE_INTEGER size;
+			if (!GetFileSizeEx(file, &size)) {
+				m_error = EIO;
+				CloseHandle(file);
+				return;
+			}
+			if (size.QuadPart == 0) {
+				CloseHandle(file);
+				m_data = empty;
+				return;
+			}
+			m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			CloseHandle(file);
+			if (m_mapping == nullptr) {
+				m_error = EIO;
+				return;
+			}
+			m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+			if (m_data == nullptr) {
+				m_error = EIO;
+				CloseHandle(m_mapping);
+				m_mapping = nullptr;
+				return;
+			}
+			m_size = static_cast<std::size_t>(size.QuadPart);
+#elif SOL_IS_ON(SOL_PLATFORM_UNIXLIKE_I_)
+			int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+			if (fd < 0) {
+				m_error = errno;
+				return;
+			}
+			struct stat info;
+			if (::fstat(fd, &info) != 0) {
+				m_error = errno;
+				::close(fd);
+				return;
+			}
+			if (info.st_size == 0) {
+				::close(fd);
+				m_data = empty;
+				return;
+			}
+			void* memory = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+			int map_error = errno;
+			// the mapping keeps the file alive on its own
+			::close(fd);
+			if (memory == MAP_FAILED) {
+				m_error = map_error;
+				return;
+			}
+			m_data = static_cast<const char*>(memory);
+			m_size = static_cast<std::size_t>(info.st_size);
+#else
+			std::ifstream in(filename, std::ios::binary);
+			if (!in) {
+				m_error = ENOENT;
+				return;
+			}
+			m_contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+			m_data = m_contents.empty() ? empty : m_contents.data();
+			m_size = m_contents.size();
+#endif
+		}
+
+		mapped_file(const mapped_file&) = delete;
+		mapped_file& operator=(const mapped_file&) = delete;
+
+		mapped_file(mapped_file&& other) noexcept : mapped_file() {
+			*this = std::move(other);
+		}
+
+		mapped_file& operator=(mapped_file&& other) noexcept {
+			if (this == &other) {
+				return *this;
+			}
+			unmap();
+			m_data = std::exchange(other.m_data, nullptr);
+			m_size = std::exchange(other.m_size, 0);
+			m_error = std::exchange(other.m_error, 0);
+#if SOL_IS_ON(SOL_PLATFORM_WINDOWS_I_)
+			m_mapping = std::exchange(other.m_mapping, nullptr);
+#elif SOL_IS_OFF(SOL_PLATFORM_UNIXLIKE_I_)
+			m_contents = std::move(other.m_contents);
+			other.m_contents.clear();
+#endif
+			return *this;
+		}
+
+		~mapped_file() {
+			unmap();
+		}
+
+		bool valid() const noexcept {
+			return m_data != nullptr;
+		}
+
+		explicit operator bool() const noexcept {
+			return valid();
+		}
+
+		// the errno-style reason the file could not be opened or mapped, or 0
+		int error() const noexcept {
+			return m_error;
+		}
+
+		const char* data() const noexcept {
+			return m_data;
+		}
+
+		std::size_t size() const noexcept {
+			return m_size;
+		}
+
+		string_view as_string_view() const noexcept {
+			return string_view(m_data != nullptr ? m_data : "", m_size);
+		}
+	};
+
+	namespace stack {
+		// same contract as luaL_loadfilex, including skipping a UTF-8 byte order mark and a leading '#' line,
+		// but the chunk is handed to Lua straight out of the mapping
+		inline int load_mapped_file(lua_State* L, const std::string& filename, load_mode mode = load_mode::any) {
+			mapped_file file(filename);
+			if (!file) {
+				lua_pushfstring(L, "cannot open %s: %s", filename.c_str(), std::strerror(file.error()));
+				return LUA_ERRFILE;
+			}
+			string_view code = file.as_string_view();
+			if (code.size() >= 3 && code.substr(0, 3) == "\xEF\xBB\xBF") {
+				code.remove_prefix(3);
+			}
+			if (!code.empty() && code[0] == '#') {
+				// keep the newline, so line numbers still match the file
+				std::size_t line_end = code.find('\n');
+				code.remove_prefix(line_end == string_view::npos ? code.size() : line_end);
+				if (code.size() > 1 && code[1] == LUA_SIGNATURE[0]) {
+					code.remove_prefix(1);
+				}
+			}
+			std::string chunkname = "@" + filename;
+			return luaL_loadbufferx(L, code.data(), code.size(), chunkname.c_str(), to_string(mode).c_str());
+		}
+	} // namespace stack
+
+	inline load_result load_mapped_file(lua_State* L, const std::string& filename, load_mode mode = load_mode::any) {
+		load_status x = static_cast<load_status>(stack::load_mapped_file(L, filename, mode));
+		return load_result(L, absolute_index(L, -1), 1, 1, x);
+	}
+
+	// makes every script_file, load_file and require_file call on a state read through load_mapped_file
+	class mapped_file_loader : public detail::file_loader {
+	public:
+		int load_file(lua_State* L, const std::string& filename, load_mode mode) override {
+			return stack::load_mapped_file(L, filename, mode);
+		}
+
+		// the loader must outlive the state, or be uninstalled first
+		void install(lua_State* L) {
+			lua_pushlightuserdata(L, static_cast<detail::file_loader*>(this));
+			lua_setfield(L, LUA_REGISTRYINDEX, detail::default_file_loader_name());
+		}
+
+		static void uninstall(lua_State* L) {
+			lua_pushnil(L);
+			lua_setfield(L, LUA_REGISTRYINDEX, detail::default_file_loader_name());
+		}
+	};
+
+} // namespace sol
+
+#endif // SOL_MAPPED_FILE_HPP
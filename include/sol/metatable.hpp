@@ -152,6 +152,7 @@ namespace sol {
 
 			// destroy all storage and tables
 			base_storage.clear();
+			stack::stack_detail::clear_metatable_cache(L);
 
 			// 6 strings from gc_names table,
 			// + 1 registry,
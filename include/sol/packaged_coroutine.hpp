@@ -40,6 +40,8 @@ namespace sol {
 		sol::stateless_reference m_coroutine_reference;
 		sol::reference m_error_handler;
 		sol::thread m_thread_reference;
+		// set by the constructors that are not given a handler (see detail::is_borrowed_default_handler)
+		bool uses_default_handler = false;
 
 		void luacall(std::ptrdiff_t argcount, std::ptrdiff_t) {
 #if SOL_LUA_VESION_I_ >= 504
@@ -73,9 +75,8 @@ namespace sol {
 			int poststacksize = lua_gettop(this->lua_state());
 			int returncount = poststacksize - (firstreturn - 1);
 			if (error()) {
-				if (error_handler.valid()) {
+				if (detail::try_push_error_handler(this->lua_state(), error_handler, uses_default_handler)) {
 					string_view err = stack::get<string_view>(this->lua_state(), poststacksize);
-					error_handler.push();
 					stack::push(this->lua_state(), err);
 					lua_call(lua_state(), 1, 1);
 				}
@@ -93,7 +94,8 @@ namespace sol {
 		          meta::neg<std::is_base_of<proxy_base_tag, meta::unqualified_t<T>>>, meta::neg<std::is_same<base_t, stack_reference>>,
 		          meta::neg<std::is_same<lua_nil_t, meta::unqualified_t<T>>>, is_lua_reference<meta::unqualified_t<T>>> = meta::enabler>
 		basic_packaged_coroutine(T&& r) noexcept
-		: base_t(std::forward<T>(r)), error_handler(detail::get_default_handler<reference, is_main_threaded<base_t>::value>(r.lua_state())) {
+		: base_t(std::forward<T>(r)), error_handler(detail::borrow_default_handler<reference, is_main_threaded<base_t>::value>(r.lua_state())) {
+			uses_default_handler = true;
 #if SOL_IS_ON(SOL_SAFE_REFERENCES_I_)
 			if (!is_function<meta::unqualified_t<T>>::value) {
 				auto pp = stack::push_pop(*this);
@@ -107,32 +109,39 @@ namespace sol {
 		basic_packaged_coroutine& operator=(const basic_packaged_coroutine&) = default;
 
 		basic_packaged_coroutine(basic_packaged_coroutine&& other) noexcept
-		: base_t(std::move(other)), error_handler(this->lua_state(), std::move(other.error_handler)) {
+		: base_t(std::move(other))
+		, error_handler(detail::rebind_error_handler(this->lua_state(), std::move(other.error_handler)))
+		, uses_default_handler(other.uses_default_handler) {
 		}
 
 		basic_packaged_coroutine& operator=(basic_packaged_coroutine&& other) noexcept {
 			base_t::operator=(std::move(other));
 			// must change the state, since it could change on the coroutine type
 			error_handler.abandon();
-			error_handler = handler_t(this->lua_state(), std::move(other.error_handler));
+			error_handler = detail::rebind_error_handler(this->lua_state(), std::move(other.error_handler));
+			uses_default_handler = other.uses_default_handler;
 			return *this;
 		}
 
 		basic_packaged_coroutine(const basic_function<base_t>& b) noexcept
-		: basic_packaged_coroutine(b, detail::get_default_handler<reference, is_main_threaded<base_t>::value>(b.lua_state())) {
+		: basic_packaged_coroutine(b, detail::borrow_default_handler<reference, is_main_threaded<base_t>::value>(b.lua_state())) {
+			uses_default_handler = true;
 		}
 		basic_packaged_coroutine(basic_function<base_t>&& b) noexcept
-		: basic_packaged_coroutine(std::move(b), detail::get_default_handler<reference, is_main_threaded<base_t>::value>(b.lua_state())) {
+		: basic_packaged_coroutine(std::move(b), detail::borrow_default_handler<reference, is_main_threaded<base_t>::value>(b.lua_state())) {
+			uses_default_handler = true;
 		}
 		basic_packaged_coroutine(const basic_function<base_t>& b, handler_t eh) noexcept : base_t(b), error_handler(std::move(eh)) {
 		}
 		basic_packaged_coroutine(basic_function<base_t>&& b, handler_t eh) noexcept : base_t(std::move(b)), error_handler(std::move(eh)) {
 		}
 		basic_packaged_coroutine(const stack_reference& r) noexcept
-		: basic_packaged_coroutine(r.lua_state(), r.stack_index(), detail::get_default_handler<reference, is_main_threaded<base_t>::value>(r.lua_state())) {
+		: basic_packaged_coroutine(r.lua_state(), r.stack_index(), detail::borrow_default_handler<reference, is_main_threaded<base_t>::value>(r.lua_state())) {
+			uses_default_handler = true;
 		}
 		basic_packaged_coroutine(stack_reference&& r) noexcept
-		: basic_packaged_coroutine(r.lua_state(), r.stack_index(), detail::get_default_handler<reference, is_main_threaded<base_t>::value>(r.lua_state())) {
+		: basic_packaged_coroutine(r.lua_state(), r.stack_index(), detail::borrow_default_handler<reference, is_main_threaded<base_t>::value>(r.lua_state())) {
+			uses_default_handler = true;
 		}
 		basic_packaged_coroutine(const stack_reference& r, handler_t eh) noexcept : basic_packaged_coroutine(r.lua_state(), r.stack_index(), std::move(eh)) {
 		}
@@ -141,11 +150,13 @@ namespace sol {
 
 		template <typename Super>
 		basic_packaged_coroutine(const proxy_base<Super>& p)
-		: basic_packaged_coroutine(p, detail::get_default_handler<reference, is_main_threaded<base_t>::value>(p.lua_state())) {
+		: basic_packaged_coroutine(p, detail::borrow_default_handler<reference, is_main_threaded<base_t>::value>(p.lua_state())) {
+			uses_default_handler = true;
 		}
 		template <typename Super>
 		basic_packaged_coroutine(proxy_base<Super>&& p)
-		: basic_packaged_coroutine(std::move(p), detail::get_default_handler<reference, is_main_threaded<base_t>::value>(p.lua_state())) {
+		: basic_packaged_coroutine(std::move(p), detail::borrow_default_handler<reference, is_main_threaded<base_t>::value>(p.lua_state())) {
+			uses_default_handler = true;
 		}
 		template <typename Proxy, typename Handler,
 		     meta::enable<std::is_base_of<proxy_base_tag, meta::unqualified_t<Proxy>>, meta::neg<is_lua_index<meta::unqualified_t<Handler>>>> = meta::enabler>
@@ -154,7 +165,8 @@ namespace sol {
 
 		template <typename T, meta::enable<is_lua_reference<meta::unqualified_t<T>>> = meta::enabler>
 		basic_packaged_coroutine(lua_State* L, T&& r) noexcept
-		: basic_packaged_coroutine(L, std::forward<T>(r), detail::get_default_handler<reference, is_main_threaded<base_t>::value>(L)) {
+		: basic_packaged_coroutine(L, std::forward<T>(r), detail::borrow_default_handler<reference, is_main_threaded<base_t>::value>(L)) {
+			uses_default_handler = true;
 		}
 		template <typename T, meta::enable<is_lua_reference<meta::unqualified_t<T>>> = meta::enabler>
 		basic_packaged_coroutine(lua_State* L, T&& r, handler_t eh) : base_t(L, std::forward<T>(r)), error_handler(std::move(eh)) {
@@ -169,7 +181,8 @@ namespace sol {
 		}
 
 		basic_packaged_coroutine(lua_State* L, int index = -1)
-		: basic_packaged_coroutine(L, index, detail::get_default_handler<reference, is_main_threaded<base_t>::value>(L)) {
+		: basic_packaged_coroutine(L, index, detail::borrow_default_handler<reference, is_main_threaded<base_t>::value>(L)) {
+			uses_default_handler = true;
 		}
 		basic_packaged_coroutine(lua_State* L, int index, handler_t eh) : base_t(L, index), error_handler(std::move(eh)) {
 #ifdef SOL_SAFE_REFERENCES
@@ -178,7 +191,8 @@ namespace sol {
 #endif // Safety
 		}
 		basic_packaged_coroutine(lua_State* L, absolute_index index)
-		: basic_packaged_coroutine(L, index, detail::get_default_handler<reference, is_main_threaded<base_t>::value>(L)) {
+		: basic_packaged_coroutine(L, index, detail::borrow_default_handler<reference, is_main_threaded<base_t>::value>(L)) {
+			uses_default_handler = true;
 		}
 		basic_packaged_coroutine(lua_State* L, absolute_index index, handler_t eh) : base_t(L, index), error_handler(std::move(eh)) {
 #if SOL_IS_ON(SOL_SAFE_REFERENCES_I_)
@@ -187,7 +201,8 @@ namespace sol {
 #endif // Safety
 		}
 		basic_packaged_coroutine(lua_State* L, raw_index index)
-		: basic_packaged_coroutine(L, index, detail::get_default_handler<reference, is_main_threaded<base_t>::value>(L)) {
+		: basic_packaged_coroutine(L, index, detail::borrow_default_handler<reference, is_main_threaded<base_t>::value>(L)) {
+			uses_default_handler = true;
 		}
 		basic_packaged_coroutine(lua_State* L, raw_index index, handler_t eh) : base_t(L, index), error_handler(std::move(eh)) {
 #if SOL_IS_ON(SOL_SAFE_REFERENCES_I_)
@@ -196,7 +211,8 @@ namespace sol {
 #endif // Safety
 		}
 		basic_packaged_coroutine(lua_State* L, ref_index index)
-		: basic_packaged_coroutine(L, index, detail::get_default_handler<reference, is_main_threaded<base_t>::value>(L)) {
+		: basic_packaged_coroutine(L, index, detail::borrow_default_handler<reference, is_main_threaded<base_t>::value>(L)) {
+			uses_default_handler = true;
 		}
 		basic_packaged_coroutine(lua_State* L, ref_index index, handler_t eh) : base_t(L, index), error_handler(std::move(eh)) {
 #if SOL_IS_ON(SOL_SAFE_REFERENCES_I_)
@@ -44,7 +44,7 @@ namespace sol {
 		     lua_State* L_, optional<const std::exception&> maybe_ex, const char* error, detail::protected_handler<b, handler_t>& h) {
 			h.stack_index = 0;
 			if (b) {
-				h.target.push();
+				detail::push_error_handler(h.target.lua_state(), h.target, h.uses_default_handler);
 				detail::call_exception_handler(L_, maybe_ex, error);
 				lua_call(L_, 1, 1);
 			}
@@ -72,6 +72,13 @@ namespace sol {
 		}
 
 	private:
+		// set by the constructors that are not given a handler (see detail::is_borrowed_default_handler)
+		bool uses_default_handler = false;
+
+		static handler_t borrow_default_handler(lua_State* L_) {
+			return detail::borrow_default_handler<handler_t, is_main_threaded<base_t>::value>(L_);
+		}
+
 		template <bool b>
 		call_status luacall(std::ptrdiff_t argcount, std::ptrdiff_t result_count_, detail::protected_handler<b, handler_t>& h) const {
 			return static_cast<call_status>(lua_pcall(lua_state(), static_cast<int>(argcount), static_cast<int>(result_count_), h.stack_index));
@@ -152,7 +159,8 @@ namespace sol {
 		     meta::enable<meta::neg<std::is_same<meta::unqualified_t<T>, basic_protected_function>>,
 		          meta::neg<std::is_base_of<proxy_base_tag, meta::unqualified_t<T>>>, meta::neg<std::is_same<base_t, stack_reference>>,
 		          meta::neg<std::is_same<lua_nil_t, meta::unqualified_t<T>>>, is_lua_reference<meta::unqualified_t<T>>> = meta::enabler>
-		basic_protected_function(T&& r) noexcept : base_t(std::forward<T>(r)), error_handler(get_default_handler(r.lua_state())) {
+		basic_protected_function(T&& r) noexcept : base_t(std::forward<T>(r)), error_handler(borrow_default_handler(r.lua_state())) {
+			uses_default_handler = true;
 #if SOL_IS_ON(SOL_SAFE_REFERENCES_I_)
 			if (!is_function<meta::unqualified_t<T>>::value) {
 				auto pp = stack::push_pop(*this);
@@ -165,17 +173,21 @@ namespace sol {
 		basic_protected_function& operator=(const basic_protected_function&) = default;
 		basic_protected_function(basic_protected_function&&) = default;
 		basic_protected_function& operator=(basic_protected_function&&) = default;
-		basic_protected_function(const basic_function<base_t>& b) : basic_protected_function(b, get_default_handler(b.lua_state())) {
+		basic_protected_function(const basic_function<base_t>& b) : basic_protected_function(b, borrow_default_handler(b.lua_state())) {
+			uses_default_handler = true;
 		}
-		basic_protected_function(basic_function<base_t>&& b) : basic_protected_function(std::move(b), get_default_handler(b.lua_state())) {
+		basic_protected_function(basic_function<base_t>&& b) : basic_protected_function(std::move(b), borrow_default_handler(b.lua_state())) {
+			uses_default_handler = true;
 		}
 		basic_protected_function(const basic_function<base_t>& b, handler_t eh) : base_t(b), error_handler(std::move(eh)) {
 		}
 		basic_protected_function(basic_function<base_t>&& b, handler_t eh) : base_t(std::move(b)), error_handler(std::move(eh)) {
 		}
-		basic_protected_function(const stack_reference& r) : basic_protected_function(r.lua_state(), r.stack_index(), get_default_handler(r.lua_state())) {
+		basic_protected_function(const stack_reference& r) : basic_protected_function(r.lua_state(), r.stack_index(), borrow_default_handler(r.lua_state())) {
+			uses_default_handler = true;
 		}
-		basic_protected_function(stack_reference&& r) : basic_protected_function(r.lua_state(), r.stack_index(), get_default_handler(r.lua_state())) {
+		basic_protected_function(stack_reference&& r) : basic_protected_function(r.lua_state(), r.stack_index(), borrow_default_handler(r.lua_state())) {
+			uses_default_handler = true;
 		}
 		basic_protected_function(const stack_reference& r, handler_t eh) : basic_protected_function(r.lua_state(), r.stack_index(), std::move(eh)) {
 		}
@@ -183,10 +195,12 @@ namespace sol {
 		}
 
 		template <typename Super>
-		basic_protected_function(const proxy_base<Super>& p) : basic_protected_function(p, get_default_handler(p.lua_state())) {
+		basic_protected_function(const proxy_base<Super>& p) : basic_protected_function(p, borrow_default_handler(p.lua_state())) {
+			uses_default_handler = true;
 		}
 		template <typename Super>
-		basic_protected_function(proxy_base<Super>&& p) : basic_protected_function(std::move(p), get_default_handler(p.lua_state())) {
+		basic_protected_function(proxy_base<Super>&& p) : basic_protected_function(std::move(p), borrow_default_handler(p.lua_state())) {
+			uses_default_handler = true;
 		}
 		template <typename Proxy, typename Handler,
 		     meta::enable<std::is_base_of<proxy_base_tag, meta::unqualified_t<Proxy>>, meta::neg<is_lua_index<meta::unqualified_t<Handler>>>> = meta::enabler>
@@ -194,7 +208,8 @@ namespace sol {
 		}
 
 		template <typename T, meta::enable<is_lua_reference<meta::unqualified_t<T>>> = meta::enabler>
-		basic_protected_function(lua_State* L_, T&& r) : basic_protected_function(L_, std::forward<T>(r), get_default_handler(L_)) {
+		basic_protected_function(lua_State* L_, T&& r) : basic_protected_function(L_, std::forward<T>(r), borrow_default_handler(L_)) {
+			uses_default_handler = true;
 		}
 		template <typename T, meta::enable<is_lua_reference<meta::unqualified_t<T>>> = meta::enabler>
 		basic_protected_function(lua_State* L_, T&& r, handler_t eh) : base_t(L_, std::forward<T>(r)), error_handler(std::move(eh)) {
@@ -208,7 +223,8 @@ namespace sol {
 		basic_protected_function(lua_nil_t n) : base_t(n), error_handler(n) {
 		}
 
-		basic_protected_function(lua_State* L_, int index_ = -1) : basic_protected_function(L_, index_, get_default_handler(L_)) {
+		basic_protected_function(lua_State* L_, int index_ = -1) : basic_protected_function(L_, index_, borrow_default_handler(L_)) {
+			uses_default_handler = true;
 		}
 		basic_protected_function(lua_State* L_, int index_, handler_t eh) : base_t(L_, index_), error_handler(std::move(eh)) {
 #if SOL_IS_ON(SOL_SAFE_REFERENCES_I_)
@@ -216,7 +232,8 @@ namespace sol {
 			stack::check<basic_protected_function>(L_, index_, handler);
 #endif // Safety
 		}
-		basic_protected_function(lua_State* L_, absolute_index index_) : basic_protected_function(L_, index_, get_default_handler(L_)) {
+		basic_protected_function(lua_State* L_, absolute_index index_) : basic_protected_function(L_, index_, borrow_default_handler(L_)) {
+			uses_default_handler = true;
 		}
 		basic_protected_function(lua_State* L_, absolute_index index_, handler_t eh) : base_t(L_, index_), error_handler(std::move(eh)) {
 #if SOL_IS_ON(SOL_SAFE_REFERENCES_I_)
@@ -224,7 +241,8 @@ namespace sol {
 			stack::check<basic_protected_function>(L_, index_, handler);
 #endif // Safety
 		}
-		basic_protected_function(lua_State* L_, raw_index index_) : basic_protected_function(L_, index_, get_default_handler(L_)) {
+		basic_protected_function(lua_State* L_, raw_index index_) : basic_protected_function(L_, index_, borrow_default_handler(L_)) {
+			uses_default_handler = true;
 		}
 		basic_protected_function(lua_State* L_, raw_index index_, handler_t eh) : base_t(L_, index_), error_handler(std::move(eh)) {
 #if SOL_IS_ON(SOL_SAFE_REFERENCES_I_)
@@ -232,7 +250,8 @@ namespace sol {
 			stack::check<basic_protected_function>(L_, index_, handler);
 #endif // Safety
 		}
-		basic_protected_function(lua_State* L_, ref_index index_) : basic_protected_function(L_, index_, get_default_handler(L_)) {
+		basic_protected_function(lua_State* L_, ref_index index_) : basic_protected_function(L_, index_, borrow_default_handler(L_)) {
+			uses_default_handler = true;
 		}
 		basic_protected_function(lua_State* L_, ref_index index_, handler_t eh) : base_t(L_, index_), error_handler(std::move(eh)) {
 #if SOL_IS_ON(SOL_SAFE_REFERENCES_I_)
@@ -285,8 +304,8 @@ namespace sol {
 		decltype(auto) call(Args&&... args) const {
 			if constexpr (!aligned) {
 				// we do not expect the function to already be on the stack: push it
-				if (error_handler.valid()) {
-					detail::protected_handler<true, handler_t> h(error_handler);
+				if (detail::try_push_error_handler(lua_state(), error_handler, uses_default_handler)) {
+					detail::protected_handler<true, handler_t> h(error_handler, lua_gettop(lua_state()), uses_default_handler);
 					base_t::push();
 					int pushcount = stack::multi_push_reference(lua_state(), std::forward<Args>(args)...);
 					return invoke(types<Ret...>(), std::make_index_sequence<sizeof...(Ret)>(), pushcount, h);
@@ -300,27 +319,23 @@ namespace sol {
 			}
 			else {
 				// the function is already on the stack at the right location
-				if (error_handler.valid()) {
-					// the handler will be pushed onto the stack manually,
-					// since it's not already on the stack this means we need to push our own
-					// function on the stack too and swap things to be in-place
-					if constexpr (!is_stack_handler::value) {
-						// so, we need to remove the function at the top and then dump the handler out ourselves
-						base_t::push();
-					}
-					detail::protected_handler<true, handler_t> h(error_handler);
-					if constexpr (!is_stack_handler::value) {
-						lua_replace(lua_state(), -3);
-						h.stack_index = lua_absindex(lua_state(), -2);
+				if constexpr (is_stack_handler::value) {
+					if (detail::has_error_handler(lua_state(), error_handler, uses_default_handler)) {
+						detail::protected_handler<true, handler_t> h(error_handler);
+						int pushcount = stack::multi_push_reference(lua_state(), std::forward<Args>(args)...);
+						return invoke(types<Ret...>(), std::make_index_sequence<sizeof...(Ret)>(), pushcount, h);
 					}
-					int pushcount = stack::multi_push_reference(lua_state(), std::forward<Args>(args)...);
-					return invoke(types<Ret...>(), std::make_index_sequence<sizeof...(Ret)>(), pushcount, h);
 				}
-				else {
-					detail::protected_handler<false, handler_t> h(error_handler);
+				else if (detail::try_push_error_handler(lua_state(), error_handler, uses_default_handler)) {
+					// the handler landed above the function: move it underneath, in-place
+					lua_insert(lua_state(), -2);
+					detail::protected_handler<true, handler_t> h(error_handler, lua_absindex(lua_state(), -2), uses_default_handler);
 					int pushcount = stack::multi_push_reference(lua_state(), std::forward<Args>(args)...);
 					return invoke(types<Ret...>(), std::make_index_sequence<sizeof...(Ret)>(), pushcount, h);
 				}
+				detail::protected_handler<false, handler_t> h(error_handler);
+				int pushcount = stack::multi_push_reference(lua_state(), std::forward<Args>(args)...);
+				return invoke(types<Ret...>(), std::make_index_sequence<sizeof...(Ret)>(), pushcount, h);
 			}
 		}
 	};
@@ -31,9 +31,121 @@
 #include <cstdint>
 
 namespace sol { namespace detail {
-	inline const char (&default_handler_name())[9] {
-		static const char name[9] = "sol.\xF0\x9F\x94\xA9";
-		return name;
+	// the default handler is kept under a light userdata key in the registry,
+	// which is a pointer-hashed raw lookup rather than a string-keyed one
+	inline const void* default_handler_key() {
+		static const char key = 0;
+		return &key;
+	}
+
+	template <typename Reference, bool is_main_ref = false>
+	static Reference get_default_handler(lua_State* L) {
+		if (is_stack_based<Reference>::value || L == nullptr)
+			return Reference(L, lua_nil);
+		L = is_main_ref ? main_thread(L, L) : L;
+		lua_rawgetp(L, LUA_REGISTRYINDEX, default_handler_key());
+		auto pp = stack::pop_n(L, 1);
+		return Reference(L, -1);
+	}
+
+	// objects constructed without a handler hold an empty reference still bound to their state, and are marked as
+	// using the default handler: that costs no registry reference, and the handler is fetched from the registry when needed
+	template <typename Reference, bool is_main_ref = false>
+	static Reference borrow_default_handler(lua_State* L) {
+		if (is_stack_based<Reference>::value || L == nullptr)
+			return Reference(L, lua_nil);
+		L = is_main_ref ? main_thread(L, L) : L;
+		return Reference(L, lua_nil);
+	}
+
+	// the mark is what tells the two apart from a nil handler that was passed in on purpose,
+	// which looks exactly the same and turns error handling off
+	template <typename Reference>
+	bool is_borrowed_default_handler(const Reference& handler, bool uses_default_handler) noexcept {
+		if constexpr (is_stack_based<Reference>::value) {
+			(void)handler;
+			(void)uses_default_handler;
+			return false;
+		}
+		else {
+			return uses_default_handler && handler.lua_state() != nullptr && handler.registry_index() == LUA_NOREF;
+		}
+	}
+
+	inline bool push_default_handler(lua_State* L) {
+#if SOL_IS_ON(SOL_SAFE_STACK_CHECK_I_)
+		luaL_checkstack(L, 1, detail::not_enough_stack_space_generic);
+#endif // make sure stack doesn't overflow
+		lua_rawgetp(L, LUA_REGISTRYINDEX, default_handler_key());
+		return !lua_isnil(L, -1);
+	}
+
+	template <typename Reference>
+	bool has_error_handler(lua_State* L, const Reference& handler, bool uses_default_handler) {
+		if (handler.valid()) {
+			return true;
+		}
+		if (!is_borrowed_default_handler(handler, uses_default_handler)) {
+			return false;
+		}
+		bool present = push_default_handler(L);
+		lua_pop(L, 1);
+		return present;
+	}
+
+	// pushes the handler a call should use and reports whether there is one:
+	// if there is none, nothing is left on the stack, so a call looks the
+	// default handler up once instead of checking for it and then pushing it
+	template <typename Reference>
+	bool try_push_error_handler(lua_State* L, const Reference& handler, bool uses_default_handler) {
+		if (handler.valid()) {
+			handler.push(L);
+			return true;
+		}
+		if (!is_borrowed_default_handler(handler, uses_default_handler)) {
+			return false;
+		}
+		if (push_default_handler(L)) {
+			return true;
+		}
+		lua_pop(L, 1);
+		return false;
+	}
+
+	template <typename Reference>
+	void push_error_handler(lua_State* L, const Reference& handler, bool uses_default_handler) {
+		if (handler.valid() || !is_borrowed_default_handler(handler, uses_default_handler)) {
+			handler.push(L);
+			return;
+		}
+		push_default_handler(L);
+	}
+
+	template <typename Reference>
+	Reference rebind_error_handler(lua_State* L, Reference&& handler) {
+		// a handler that was explicitly cleared must not turn into a borrowed default when moved
+		if (handler.lua_state() == nullptr) {
+			return Reference();
+		}
+		return Reference(L, std::move(handler));
+	}
+
+	template <typename T>
+	static void set_default_handler(lua_State* L, const T& ref) {
+		if (L == nullptr) {
+			return;
+		}
+		if (!ref.valid()) {
+#if SOL_IS_ON(SOL_SAFE_STACK_CHECK_I_)
+			luaL_checkstack(L, 1, detail::not_enough_stack_space_generic);
+#endif // make sure stack doesn't overflow
+			lua_pushnil(L);
+			lua_rawsetp(L, LUA_REGISTRYINDEX, default_handler_key());
+		}
+		else {
+			ref.push(L);
+			lua_rawsetp(L, LUA_REGISTRYINDEX, default_handler_key());
+		}
 	}
 
 	template <bool b, typename target_t = reference>
@@ -41,15 +153,16 @@ namespace sol { namespace detail {
 		typedef is_stack_based<target_t> is_stack;
 		const target_t& target;
 		int stack_index;
+		bool uses_default_handler;
 
-		protected_handler(std::false_type, const target_t& target_) : target(target_), stack_index(0) {
+		protected_handler(std::false_type, const target_t& target_) : target(target_), stack_index(0), uses_default_handler(false) {
 			if (b) {
 				stack_index = lua_gettop(target.lua_state()) + 1;
-				target.push();
+				push_error_handler(target.lua_state(), target, uses_default_handler);
 			}
 		}
 
-		protected_handler(std::true_type, const target_t& target_) : target(target_), stack_index(0) {
+		protected_handler(std::true_type, const target_t& target_) : target(target_), stack_index(0), uses_default_handler(false) {
 			if (b) {
 				stack_index = target.stack_index();
 			}
@@ -58,6 +171,11 @@ namespace sol { namespace detail {
 		protected_handler(const target_t& target_) : protected_handler(is_stack(), target_) {
 		}
 
+		// adopts a handler that try_push_error_handler already left at handler_index
+		protected_handler(const target_t& target_, int handler_index, bool uses_default_handler_)
+		: target(target_), stack_index(handler_index), uses_default_handler(uses_default_handler_) {
+		}
+
 		bool valid() const noexcept {
 			return b;
 		}
@@ -75,34 +193,6 @@ namespace sol { namespace detail {
 	basic_function<base_t> force_cast(T& p) {
 		return p;
 	}
-
-	template <typename Reference, bool is_main_ref = false>
-	static Reference get_default_handler(lua_State* L) {
-		if (is_stack_based<Reference>::value || L == nullptr)
-			return Reference(L, lua_nil);
-		L = is_main_ref ? main_thread(L, L) : L;
-		lua_getglobal(L, default_handler_name());
-		auto pp = stack::pop_n(L, 1);
-		return Reference(L, -1);
-	}
-
-	template <typename T>
-	static void set_default_handler(lua_State* L, const T& ref) {
-		if (L == nullptr) {
-			return;
-		}
-		if (!ref.valid()) {
-#if SOL_IS_ON(SOL_SAFE_STACK_CHECK_I_)
-			luaL_checkstack(L, 1, detail::not_enough_stack_space_generic);
-#endif // make sure stack doesn't overflow
-			lua_pushnil(L);
-			lua_setglobal(L, default_handler_name());
-		}
-		else {
-			ref.push(L);
-			lua_setglobal(L, default_handler_name());
-		}
-	}
 }} // namespace sol::detail
 
 #endif // SOL_PROTECTED_HANDLER_HPP
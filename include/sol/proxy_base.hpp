@@ -32,9 +32,14 @@ namespace sol {
 	struct proxy_base_tag { };
 
 	namespace detail {
+		// arrays and named key_paths are held by reference, not copied into the proxy
+		template <typename T>
+		inline constexpr bool is_proxy_key_by_reference_v = std::is_array_v<meta::unqualified_t<T>>
+		     || (std::is_lvalue_reference_v<T> && std::is_same_v<meta::unqualified_t<T>, key_path>);
+
 		template <typename T>
 		using proxy_key_t = meta::conditional_t<meta::is_specialization_of_v<meta::unqualified_t<T>, std::tuple>, T,
-		     std::tuple<meta::conditional_t<std::is_array_v<meta::unqualified_t<T>>, std::remove_reference_t<T>&, meta::unqualified_t<T>>>>;
+		     std::tuple<meta::conditional_t<is_proxy_key_by_reference_v<T>, std::remove_reference_t<T>&, meta::unqualified_t<T>>>>;
 	}
 
 #define SOL_PROXY_BASE_IMPL_MSVC_IS_TRASH_I_(Super)                                                                                                          \
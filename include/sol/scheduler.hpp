@@ -0,0 +1,431 @@
+// sol3
+
+// The MIT License (MIT)
+
+// Copyright (c) 2013-2020 Rapptz, ThePhD and contributors
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SOL_SCHEDULER_HPP
+#define SOL_SCHEDULER_HPP
+
+#include <sol/thread_pool.hpp>
+#include <sol/function.hpp>
+#include <sol/table.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#if SOL_IS_ON(SOL_PRINT_ERRORS_I_)
+#include <iostream>
+#endif
+
+namespace sol {
+
+	// runs Lua functions as cooperative tasks: a task only costs time on the ticks where it can actually run,
+	// since sleeping tasks sit in a timer heap or a signal list rather than being resumed to check on themselves
+	class scheduler {
+	public:
+		typedef std::uint64_t task_id;
+		typedef std::function<void(task_id, const std::string&)> error_callback;
+
+	private:
+		enum class wait_kind { none, ready, seconds, frames, predicate, signal };
+
+		struct task {
+			thread runner;
+			lua_State* L = nullptr;
+			std::uint32_t generation = 0;
+			wait_kind waiting = wait_kind::none;
+			int pending_args = 0;
+			int predicate_ref = LUA_NOREF;
+			bool alive = false;
+		};
+
+		struct waiter {
+			std::size_t slot;
+			std::uint32_t generation;
+		};
+
+		template <typename Clock>
+		struct timed_waiter {
+			Clock when;
+			waiter who;
+
+			bool operator>(const timed_waiter& right) const noexcept {
+				return when > right.when;
+			}
+		};
+
+		template <typename Clock>
+		using timer_heap = std::priority_queue<timed_waiter<Clock>, std::vector<timed_waiter<Clock>>, std::greater<timed_waiter<Clock>>>;
+
+		static constexpr std::size_t no_task = static_cast<std::size_t>(-1);
+
+		lua_State* m_L;
+		thread_pool m_threads;
+		std::vector<task> m_tasks;
+		std::vector<std::size_t> m_free_slots;
+		std::vector<waiter> m_ready;
+		std::vector<waiter> m_running;
+		timer_heap<double> m_timers;
+		timer_heap<std::uint64_t> m_frame_timers;
+		std::vector<waiter> m_predicates;
+		std::unordered_map<std::string, std::vector<waiter>> m_signals;
+		error_callback m_on_error;
+		double m_time;
+		std::uint64_t m_frame;
+		std::size_t m_active;
+		std::size_t m_current;
+		// the functions registered into Lua can outlive this object (in the table they were set in,
+		// or in any local a script copied them to), so they reach it only through this, which the destructor empties
+		std::shared_ptr<scheduler*> m_self;
+
+		static task_id make_id(std::size_t slot, std::uint32_t generation) noexcept {
+			return (static_cast<task_id>(generation) << 32) | static_cast<task_id>(slot);
+		}
+
+		bool is_waiting(const waiter& w, wait_kind kind) const noexcept {
+			const task& t = m_tasks[w.slot];
+			return t.alive && t.generation == w.generation && t.waiting == kind;
+		}
+
+		void make_ready(const waiter& w) {
+			m_tasks[w.slot].waiting = wait_kind::ready;
+			m_ready.push_back(w);
+		}
+
+		task* find(task_id id) noexcept {
+			std::size_t slot = static_cast<std::size_t>(id & 0xFFFFFFFFu);
+			std::uint32_t generation = static_cast<std::uint32_t>(id >> 32);
+			if (slot >= m_tasks.size() || !m_tasks[slot].alive || m_tasks[slot].generation != generation) {
+				return nullptr;
+			}
+			return &m_tasks[slot];
+		}
+
+		std::size_t allocate_slot() {
+			if (!m_free_slots.empty()) {
+				std::size_t slot = m_free_slots.back();
+				m_free_slots.pop_back();
+				return slot;
+			}
+			m_tasks.emplace_back();
+			return m_tasks.size() - 1;
+		}
+
+		void finish(std::size_t slot) {
+			task& t = m_tasks[slot];
+			if (t.predicate_ref != LUA_NOREF) {
+				luaL_unref(m_L, LUA_REGISTRYINDEX, t.predicate_ref);
+				t.predicate_ref = LUA_NOREF;
+			}
+			// the generation bump is what invalidates any entry still sitting in a heap or a list
+			++t.generation;
+			t.alive = false;
+			t.waiting = wait_kind::none;
+			t.pending_args = 0;
+			m_threads.release(t.runner);
+			t.runner = thread();
+			t.L = nullptr;
+			m_free_slots.push_back(slot);
+			--m_active;
+		}
+
+		void report(std::size_t slot, lua_State* L, int index) {
+			const char* message = lua_tostring(L, index);
+			std::string err = message != nullptr ? message : "(error object is not a string)";
+			task_id id = make_id(slot, m_tasks[slot].generation);
+			if (m_on_error) {
+				m_on_error(id, err);
+				return;
+			}
+#if SOL_IS_ON(SOL_PRINT_ERRORS_I_)
+			std::cerr << "[sol3] An error occurred in a scheduled task: ";
+			std::cerr << err;
+			std::cerr << std::endl;
+#endif
+		}
+
+		// raises a Lua error, which longjmps when Lua is built as C: callers must
+		// not have anything with a non-trivial destructor alive when calling this
+		task& current_task(lua_State* L) {
+			if (m_current == no_task || m_tasks[m_current].L != L) {
+				luaL_error(L, "sol: scheduler waits can only be used directly inside a task started by that scheduler");
+			}
+			return m_tasks[m_current];
+		}
+
+		// raises a Lua error, with the same restrictions as current_task
+		static scheduler& live(const std::shared_ptr<scheduler*>& self, lua_State* L) {
+			if (*self == nullptr) {
+				luaL_error(L, "sol: the scheduler these functions were registered by has been destroyed");
+			}
+			return **self;
+		}
+
+		waiter current_waiter() const noexcept {
+			return waiter { m_current, m_tasks[m_current].generation };
+		}
+
+		void resume(std::size_t slot) {
+			lua_State* L = m_tasks[slot].L;
+			int nargs = m_tasks[slot].pending_args;
+			m_tasks[slot].pending_args = 0;
+			m_tasks[slot].waiting = wait_kind::none;
+			m_current = slot;
+#if SOL_LUA_VESION_I_ >= 504
+			int nresults = 0;
+			int status = lua_resume(L, m_L, nargs, &nresults);
+#else
+			int status = lua_resume(L, m_L, nargs);
+#endif
+			m_current = no_task;
+			if (status == LUA_YIELD) {
+#if SOL_LUA_VESION_I_ >= 504
+				lua_pop(L, nresults);
+#else
+				lua_settop(L, 0);
+#endif
+				if (m_tasks[slot].waiting == wait_kind::none) {
+					// a plain coroutine.yield(): run again next tick
+					make_ready(waiter { slot, m_tasks[slot].generation });
+				}
+				return;
+			}
+			if (status != LUA_OK) {
+				report(slot, L, -1);
+			}
+			finish(slot);
+		}
+
+		void check_predicates() {
+			for (std::size_t i = 0; i < m_predicates.size();) {
+				waiter w = m_predicates[i];
+				if (!is_waiting(w, wait_kind::predicate)) {
+					m_predicates[i] = m_predicates.back();
+					m_predicates.pop_back();
+					continue;
+				}
+				task& t = m_tasks[w.slot];
+				lua_rawgeti(m_L, LUA_REGISTRYINDEX, t.predicate_ref);
+				int status = lua_pcall(m_L, 0, 1, 0);
+				bool done = status != LUA_OK || lua_toboolean(m_L, -1) != 0;
+				if (status != LUA_OK) {
+					report(w.slot, m_L, -1);
+				}
+				lua_pop(m_L, 1);
+				if (!done) {
+					++i;
+					continue;
+				}
+				m_predicates[i] = m_predicates.back();
+				m_predicates.pop_back();
+				if (status != LUA_OK) {
+					finish(w.slot);
+					continue;
+				}
+				luaL_unref(m_L, LUA_REGISTRYINDEX, t.predicate_ref);
+				t.predicate_ref = LUA_NOREF;
+				make_ready(w);
+			}
+		}
+
+	public:
+		explicit scheduler(lua_State* L, std::size_t thread_pool_size = 64)
+		: m_L(main_thread(L, L))
+		, m_threads(L, thread_pool_size)
+		, m_tasks()
+		, m_free_slots()
+		, m_ready()
+		, m_running()
+		, m_timers()
+		, m_frame_timers()
+		, m_predicates()
+		, m_signals()
+		, m_on_error()
+		, m_time(0)
+		, m_frame(0)
+		, m_active(0)
+		, m_current(no_task)
+		, m_self(std::make_shared<scheduler*>(this)) {
+		}
+
+		// the functions registered into Lua point back at this object
+		scheduler(const scheduler&) = delete;
+		scheduler(scheduler&&) = delete;
+		scheduler& operator=(const scheduler&) = delete;
+		scheduler& operator=(scheduler&&) = delete;
+
+		~scheduler() {
+			*m_self = nullptr;
+			for (std::size_t slot = 0; slot < m_tasks.size(); ++slot) {
+				if (m_tasks[slot].alive) {
+					finish(slot);
+				}
+			}
+		}
+
+		lua_State* lua_state() const noexcept {
+			return m_L;
+		}
+
+		// sets wait, wait_frames, wait_until, wait_signal and signal as functions in the given table
+		void register_functions(table target) {
+			target.set_function("wait", yielding([self = m_self](this_state s, double seconds) {
+				scheduler& sched = live(self, s);
+				sched.current_task(s);
+				sched.m_timers.push(timed_waiter<double> { sched.m_time + seconds, sched.current_waiter() });
+				sched.m_tasks[sched.m_current].waiting = wait_kind::seconds;
+			}));
+			target.set_function("wait_frames", yielding([self = m_self](this_state s, optional<std::uint64_t> frames) {
+				scheduler& sched = live(self, s);
+				sched.current_task(s);
+				std::uint64_t n = frames.value_or(1);
+				sched.m_frame_timers.push(timed_waiter<std::uint64_t> { sched.m_frame + (n == 0 ? 1 : n), sched.current_waiter() });
+				sched.m_tasks[sched.m_current].waiting = wait_kind::frames;
+			}));
+			target.set_function("wait_until", yielding([self = m_self](this_state s, stack_object predicate) {
+				scheduler& sched = live(self, s);
+				task& t = sched.current_task(s);
+				if (!predicate.is<function>()) {
+					luaL_error(s, "sol: wait_until expects a function or a callable object");
+				}
+				predicate.push(s);
+				t.predicate_ref = luaL_ref(s, LUA_REGISTRYINDEX);
+				t.waiting = wait_kind::predicate;
+				sched.m_predicates.push_back(sched.current_waiter());
+			}));
+			target.set_function("wait_signal", yielding([self = m_self](this_state s, string_view name) {
+				scheduler& sched = live(self, s);
+				sched.current_task(s);
+				sched.m_signals[std::string(name)].push_back(sched.current_waiter());
+				sched.m_tasks[sched.m_current].waiting = wait_kind::signal;
+			}));
+			target.set_function("signal", [self = m_self](this_state s, string_view name) { return live(self, s).signal(name); });
+		}
+
+		void set_error_callback(error_callback on_error) {
+			m_on_error = std::move(on_error);
+		}
+
+		template <typename Fx, typename... Args>
+		task_id start(Fx&& fx, Args&&... args) {
+			std::size_t slot = allocate_slot();
+			task& t = m_tasks[slot];
+			t.runner = m_threads.acquire();
+			t.L = t.runner.thread_state();
+			stack::push(t.L, std::forward<Fx>(fx));
+			t.pending_args = stack::multi_push(t.L, std::forward<Args>(args)...);
+			t.alive = true;
+			++m_active;
+			waiter w { slot, t.generation };
+			make_ready(w);
+			return make_id(slot, t.generation);
+		}
+
+		bool running(task_id id) noexcept {
+			return find(id) != nullptr;
+		}
+
+		bool cancel(task_id id) {
+			task* t = find(id);
+			if (t == nullptr || t->L == nullptr || static_cast<std::size_t>(t - m_tasks.data()) == m_current) {
+				return false;
+			}
+			finish(static_cast<std::size_t>(t - m_tasks.data()));
+			return true;
+		}
+
+		// wakes every task waiting on the signal; they run on the next update()
+		std::size_t signal(string_view name) {
+			auto it = m_signals.find(std::string(name));
+			if (it == m_signals.end()) {
+				return 0;
+			}
+			std::vector<waiter> waiters = std::move(it->second);
+			m_signals.erase(it);
+			std::size_t woken = 0;
+			for (const waiter& w : waiters) {
+				if (is_waiting(w, wait_kind::signal)) {
+					make_ready(w);
+					++woken;
+				}
+			}
+			return woken;
+		}
+
+		// advances the clock by `dt` seconds and the frame count by one, then resumes every task that became runnable;
+		// returns how many tasks were resumed
+		std::size_t update(double dt) {
+			m_time += dt;
+			++m_frame;
+			while (!m_timers.empty() && m_timers.top().when <= m_time) {
+				waiter w = m_timers.top().who;
+				m_timers.pop();
+				if (is_waiting(w, wait_kind::seconds)) {
+					make_ready(w);
+				}
+			}
+			while (!m_frame_timers.empty() && m_frame_timers.top().when <= m_frame) {
+				waiter w = m_frame_timers.top().who;
+				m_frame_timers.pop();
+				if (is_waiting(w, wait_kind::frames)) {
+					make_ready(w);
+				}
+			}
+			check_predicates();
+
+			m_running.swap(m_ready);
+			std::size_t resumed = 0;
+			for (const waiter& w : m_running) {
+				if (!is_waiting(w, wait_kind::ready)) {
+					continue;
+				}
+				resume(w.slot);
+				++resumed;
+			}
+			m_running.clear();
+			return resumed;
+		}
+
+		std::size_t size() const noexcept {
+			return m_active;
+		}
+
+		double now() const noexcept {
+			return m_time;
+		}
+
+		std::uint64_t frame() const noexcept {
+			return m_frame;
+		}
+
+		const thread_pool& threads() const noexcept {
+			return m_threads;
+		}
+	};
+
+} // namespace sol
+
+#endif // SOL_SCHEDULER_HPP
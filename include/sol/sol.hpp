@@ -53,10 +53,15 @@
 #include <sol/function.hpp>
 #include <sol/protected_function.hpp>
 #include <sol/usertype.hpp>
+#include <sol/array_view.hpp>
 #include <sol/table.hpp>
+#include <sol/key_path.hpp>
+#include <sol/table_schema.hpp>
 #include <sol/state.hpp>
 #include <sol/coroutine.hpp>
 #include <sol/thread.hpp>
+#include <sol/thread_pool.hpp>
+#include <sol/scheduler.hpp>
 #include <sol/userdata.hpp>
 #include <sol/metatable.hpp>
 #include <sol/as_args.hpp>
@@ -85,6 +85,20 @@ namespace sol {
 			stack_reference ref(registry_reference.lua_state(), -1);
 			clear_entries(ref);
 		}
+
+		// something that can stand in for luaL_loadfilex, installed in the registry under default_file_loader_name()
+		struct file_loader {
+			virtual ~file_loader() {
+			}
+
+			// same contract as luaL_loadfilex: pushes the chunk or an error message and returns the load status
+			virtual int load_file(lua_State* L, const std::string& filename, load_mode mode) = 0;
+		};
+
+		inline const char (&default_file_loader_name())[9] {
+			static const char name[9] = "sol.\xF0\x9F\x93\x82";
+			return name;
+		}
 	} // namespace detail
 
 	namespace stack {
@@ -308,8 +322,19 @@ namespace sol {
 			}
 		}
 
+		// every file sol loads goes through here, so an installed detail::file_loader sees all of them
+		inline int load_file(lua_State* L, const std::string& filename, load_mode mode = load_mode::any) {
+			lua_getfield(L, LUA_REGISTRYINDEX, detail::default_file_loader_name());
+			void* loader = lua_touserdata(L, -1);
+			lua_pop(L, 1);
+			if (loader != nullptr) {
+				return static_cast<detail::file_loader*>(loader)->load_file(L, filename, mode);
+			}
+			return luaL_loadfilex(L, filename.c_str(), to_string(mode).c_str());
+		}
+
 		inline void script_file(lua_State* L, const std::string& filename, load_mode mode = load_mode::any) {
-			if (luaL_loadfilex(L, filename.c_str(), to_string(mode).c_str()) || lua_pcall(L, 0, LUA_MULTRET, 0)) {
+			if (load_file(L, filename, mode) || lua_pcall(L, 0, LUA_MULTRET, 0)) {
 				lua_error(L);
 			}
 		}
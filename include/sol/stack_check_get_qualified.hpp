@@ -69,16 +69,18 @@ namespace sol { namespace stack {
 					memory = detail::align_usertype_unique_tag<true, false>(memory);
 					detail::unique_tag& ic = *reinterpret_cast<detail::unique_tag*>(memory);
 					memory = detail::align_usertype_unique<actual, true, false>(memory);
+					std::uint64_t ti_id = usertype_traits<element>::type_id();
 					string_view ti = usertype_traits<element>::qualified_name();
 					int cast_operation;
 					if constexpr (is_actual_type_rebindable_for_v<Tu>) {
 						using rebound_actual_type = unique_usertype_rebind_actual_t<Tu, void>;
+						std::uint64_t rebind_ti_id = usertype_traits<rebound_actual_type>::type_id();
 						string_view rebind_ti = usertype_traits<rebound_actual_type>::qualified_name();
-						cast_operation = ic(memory, &r, ti, rebind_ti);
+						cast_operation = ic(memory, &r, ti_id, ti, rebind_ti_id, rebind_ti);
 					}
 					else {
 						string_view rebind_ti("");
-						cast_operation = ic(memory, &r, ti, rebind_ti);
+						cast_operation = ic(memory, &r, ti_id, ti, 0, rebind_ti);
 					}
 					switch (cast_operation) {
 					case 1: {
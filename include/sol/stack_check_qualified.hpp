@@ -54,9 +54,11 @@ namespace sol { namespace stack {
 					if constexpr (derive<element>::value) {
 						memory = detail::align_usertype_unique_tag<true, false>(memory);
 						detail::unique_tag& ic = *reinterpret_cast<detail::unique_tag*>(memory);
+						std::uint64_t ti_id = usertype_traits<element>::type_id();
 						string_view ti = usertype_traits<element>::qualified_name();
+						std::uint64_t rebind_ti_id = usertype_traits<rebound_actual_type>::type_id();
 						string_view rebind_ti = usertype_traits<rebound_actual_type>::qualified_name();
-						if (ic(nullptr, nullptr, ti, rebind_ti) != 0) {
+						if (ic(nullptr, nullptr, ti_id, ti, rebind_ti_id, rebind_ti) != 0) {
 							return true;
 						}
 					}
@@ -38,22 +38,42 @@
 
 namespace sol { namespace stack {
 	namespace stack_detail {
-		inline bool impl_check_metatable(lua_State* L, int index, const std::string& metakey, bool poptable) {
-			luaL_getmetatable(L, &metakey[0]);
-			const type expectedmetatabletype = static_cast<type>(lua_type(L, -1));
-			if (expectedmetatabletype != type::lua_nil) {
-				if (lua_rawequal(L, -1, index) == 1) {
-					lua_pop(L, 1 + static_cast<int>(poptable));
-					return true;
+		inline bool impl_check_cached_metatable(
+		     lua_State* L, metatable_cache& cache, const void* metatable, const void* cachekey, const char* metakey, bool poptable) {
+			const void* registered = nullptr;
+			auto it = cache.metatables.find(cachekey);
+			if (it != cache.metatables.cend()) {
+				registered = it->second;
+			}
+			else {
+				const type expectedmetatabletype = static_cast<type>(get_usertype_metatable(L, cachekey, metakey));
+				if (expectedmetatabletype != type::lua_nil) {
+					// registered metatables are never replaced (only created),
+					// so remembering the address is enough from now on
+					registered = lua_topointer(L, -1);
+					cache.metatables.emplace(cachekey, registered);
 				}
+				lua_pop(L, 1);
+			}
+			if (registered != nullptr && registered == metatable) {
+				lua_pop(L, static_cast<int>(poptable));
+				return true;
 			}
-			lua_pop(L, 1);
 			return false;
 		}
 
 		template <typename T, bool poptable = true>
-		inline bool check_metatable(lua_State* L, int index = -2) {
-			return impl_check_metatable(L, index, usertype_traits<T>::metatable(), poptable);
+		inline bool check_metatable(lua_State* L, int index = -1) {
+			metatable_cache& cache = get_metatable_cache(L);
+			return impl_check_cached_metatable(
+			     L, cache, lua_topointer(L, index), usertype_cache_key<T>(), usertype_traits<T>::metatable().c_str(), poptable);
+		}
+
+		template <typename... Ts>
+		inline bool check_any_metatable(lua_State* L, int index) {
+			metatable_cache& cache = get_metatable_cache(L);
+			const void* metatable = lua_topointer(L, index);
+			return (impl_check_cached_metatable(L, cache, metatable, usertype_cache_key<Ts>(), usertype_traits<Ts>::metatable().c_str(), true) || ...);
 		}
 
 		template <type expected, int (*check_func)(lua_State*, int)>
@@ -509,13 +529,7 @@ namespace sol { namespace stack {
 					return true;
 				}
 				int metatableindex = lua_gettop(L);
-				if (stack_detail::check_metatable<U>(L, metatableindex))
-					return true;
-				if (stack_detail::check_metatable<U*>(L, metatableindex))
-					return true;
-				if (stack_detail::check_metatable<d::u<U>>(L, metatableindex))
-					return true;
-				if (stack_detail::check_metatable<as_container_t<U>>(L, metatableindex))
+				if (stack_detail::check_any_metatable<U, U*, d::u<U>, as_container_t<U>>(L, metatableindex))
 					return true;
 				bool success = false;
 				bool has_derived = derive<T>::value || weak_derive<T>::value;
@@ -529,7 +543,7 @@ namespace sol { namespace stack {
 					if (type_of(L, -1) != type::lua_nil) {
 						void* basecastdata = lua_touserdata(L, -1);
 						detail::inheritance_check_function ic = reinterpret_cast<detail::inheritance_check_function>(basecastdata);
-						success = ic(usertype_traits<T>::qualified_name());
+						success = ic(usertype_traits<T>::type_id(), usertype_traits<T>::qualified_name());
 					}
 				}
 				lua_pop(L, 1);
@@ -35,6 +35,7 @@
 #include <sol/stack_guard.hpp>
 #include <sol/demangle.hpp>
 #include <sol/forward_detail.hpp>
+#include <sol/usertype_allocation_policy.hpp>
 
 #include <vector>
 #include <bitset>
@@ -45,6 +46,7 @@
 #include <sstream>
 #include <optional>
 #include <type_traits>
+#include <unordered_map>
 
 namespace sol {
 	namespace detail {
@@ -304,6 +306,13 @@ namespace sol {
 
 		template <typename T>
 		T* usertype_allocate(lua_State* L) {
+			if constexpr (is_usertype_pooled_v<T>) {
+				// the object lives in its pool: the userdata only carries the pointer,
+				// and stays empty until usertype_construct_guard claims a slot for it
+				T** pointerpointer = usertype_allocate_pointer<T>(L);
+				*pointerpointer = nullptr;
+				return nullptr;
+			}
 			typedef std::integral_constant<bool,
 #if SOL_IS_OFF(SOL_ALIGN_MEMORY_I_)
 			     false
@@ -476,14 +485,64 @@ namespace sol {
 			return static_cast<T*>(adjusted);
 		}
 
+		// For pooled types, takes a slot for the (empty) userdata at `index` only once its metatable, and so its __gc, is set:
+		// from then on, an error that skips the guard still hands the slot back when the userdata is collected.
+		// If constructing T into the slot throws, the slot goes back to the pool and the userdata is left empty.
+		// For every other type, this does nothing.
+		template <typename T>
+		class usertype_construct_guard {
+		private:
+			T** m_owner = nullptr;
+
+		public:
+			usertype_construct_guard(lua_State* L, int index, T*& obj) {
+				if constexpr (is_usertype_pooled_v<T>) {
+					m_owner = static_cast<T**>(align_usertype_pointer(lua_touserdata(L, index)));
+					*m_owner = static_cast<T*>(usertype_allocation_policy<T>::allocate());
+					obj = *m_owner;
+				}
+				else {
+					(void)L;
+					(void)index;
+					(void)obj;
+				}
+			}
+
+			usertype_construct_guard(const usertype_construct_guard&) = delete;
+			usertype_construct_guard& operator=(const usertype_construct_guard&) = delete;
+
+			void release() noexcept {
+				m_owner = nullptr;
+			}
+
+			~usertype_construct_guard() {
+				if constexpr (is_usertype_pooled_v<T>) {
+					if (m_owner != nullptr) {
+						T* slot = *m_owner;
+						*m_owner = nullptr;
+						usertype_allocation_policy<T>::deallocate(static_cast<void*>(slot));
+					}
+				}
+			}
+		};
+
 		template <typename T>
 		int usertype_alloc_destruct(lua_State* L) noexcept {
 			void* memory = lua_touserdata(L, 1);
 			memory = align_usertype_pointer(memory);
 			T** pdata = static_cast<T**>(memory);
 			T* data = *pdata;
+			if constexpr (is_usertype_pooled_v<T>) {
+				if (data == nullptr) {
+					// never got a slot, or constructing into it failed
+					return 0;
+				}
+			}
 			std::allocator<T> alloc {};
 			std::allocator_traits<std::allocator<T>>::destroy(alloc, data);
+			if constexpr (is_usertype_pooled_v<T>) {
+				usertype_allocation_policy<T>::deallocate(static_cast<void*>(data));
+			}
 			return 0;
 		}
 
@@ -736,11 +795,26 @@ namespace sol {
 			template <typename T>
 			using strip_t = typename strip<T>::type;
 
+			// arithmetic types that move through a plain lua_pushinteger / lua_pushnumber and
+			// lua_tointeger / lua_tonumber: bool and the character types have their own
+			// pushers and getters (characters travel as strings)
+			template <typename T>
+			inline constexpr bool is_plain_number_v = std::is_arithmetic_v<T> && !meta::any_same_v<T, bool, char, wchar_t, char16_t, char32_t
+#ifdef __cpp_char8_t
+				, char8_t
+#endif // C++20 char8_t
+				>;
+
 			template <typename C>
 			static int get_size_hint(C& c) {
 				return static_cast<int>(c.size());
 			}
 
+			template <typename V, std::size_t N>
+			static int get_size_hint(V (&)[N]) {
+				return static_cast<int>(N);
+			}
+
 			template <typename V, typename Al>
 			static int get_size_hint(const std::forward_list<V, Al>&) {
 				// forward_list makes me sad
@@ -824,18 +898,104 @@ namespace sol {
 				}
 			}
 
+			// a distinct address per type, for keying per-state caches by type rather than
+			// by the address of a name; not const, so no linker ever folds two of them together
+			template <typename T>
+			inline const void* usertype_cache_key() noexcept {
+				static char key = 0;
+				return &key;
+			}
+
+			struct metatable_cache {
+				// usertype_cache_key<T>() -> address of the registered metatable
+				std::unordered_map<const void*, const void*> metatables;
+			};
+
+			inline const void* metatable_cache_key() {
+				static const char key = 0;
+				return &key;
+			}
+
+			inline metatable_cache* maybe_get_metatable_cache(lua_State* L) {
+				lua_rawgetp(L, LUA_REGISTRYINDEX, metatable_cache_key());
+				void* memory = lua_touserdata(L, -1);
+				lua_pop(L, 1);
+				if (memory == nullptr) {
+					return nullptr;
+				}
+				return static_cast<metatable_cache*>(detail::align_user<metatable_cache>(memory));
+			}
+
+			inline metatable_cache& get_metatable_cache(lua_State* L) {
+				metatable_cache* cache = maybe_get_metatable_cache(L);
+				if (cache != nullptr) {
+					return *cache;
+				}
+				// anchor the cache in the registry, so that it
+				// dies with the state (and the tables it points to)
+				cache = detail::user_allocate<metatable_cache>(L);
+				std::allocator<metatable_cache> alloc {};
+				std::allocator_traits<std::allocator<metatable_cache>>::construct(alloc, cache);
+				lua_createtable(L, 0, 1);
+				lua_CFunction cdel = detail::user_alloc_destruct<metatable_cache>;
+				lua_pushcclosure(L, cdel, 0);
+				lua_setfield(L, -2, "__gc");
+				lua_setmetatable(L, -2);
+				lua_rawsetp(L, LUA_REGISTRYINDEX, metatable_cache_key());
+				return *cache;
+			}
+
+			inline void clear_metatable_cache(lua_State* L) {
+				metatable_cache* cache = maybe_get_metatable_cache(L);
+				if (cache != nullptr) {
+					cache->metatables.clear();
+				}
+			}
+
+			// luaL_getmetatable for a usertype's own metatable: the first lookup goes by name,
+			// and also files the metatable in the registry under usertype_cache_key<T>(),
+			// so every later lookup is one raw get on a light userdata, with no name to push or hash
+			inline int get_usertype_metatable(lua_State* L, const void* cachekey, const char* key) {
+				lua_rawgetp(L, LUA_REGISTRYINDEX, cachekey);
+				if (lua_type(L, -1) == LUA_TTABLE) {
+					return LUA_TTABLE;
+				}
+				lua_pop(L, 1);
+				luaL_getmetatable(L, key);
+				int metatabletype = lua_type(L, -1);
+				if (metatabletype == LUA_TTABLE) {
+					lua_pushvalue(L, -1);
+					lua_rawsetp(L, LUA_REGISTRYINDEX, cachekey);
+				}
+				return metatabletype;
+			}
+
+			// luaL_newmetatable, filed under usertype_cache_key<T>() the same way
+			inline int new_usertype_metatable(lua_State* L, const void* cachekey, const char* key) {
+				if (get_usertype_metatable(L, cachekey, key) != LUA_TNIL) {
+					return 0;
+				}
+				lua_pop(L, 1);
+				luaL_newmetatable(L, key);
+				lua_pushvalue(L, -1);
+				lua_rawsetp(L, LUA_REGISTRYINDEX, cachekey);
+				return 1;
+			}
+
 			using undefined_method_func = void (*)(stack_reference);
 
 			struct undefined_metatable {
 				lua_State* L;
+				const void* cachekey;
 				const char* key;
 				undefined_method_func on_new_table;
 
-				undefined_metatable(lua_State* l, const char* k, undefined_method_func umf) : L(l), key(k), on_new_table(umf) {
+				undefined_metatable(lua_State* l, const void* ck, const char* k, undefined_method_func umf)
+				: L(l), cachekey(ck), key(k), on_new_table(umf) {
 				}
 
 				void operator()() const {
-					if (luaL_newmetatable(L, key) == 1) {
+					if (new_usertype_metatable(L, cachekey, key) == 1) {
 						on_new_table(stack_reference(L, -1));
 					}
 					lua_setmetatable(L, -2);
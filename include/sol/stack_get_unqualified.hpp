@@ -44,55 +44,6 @@
 namespace sol { namespace stack {
 
 	namespace stack_detail {
-		template <typename Ch>
-		struct count_code_units_utf {
-			std::size_t needed_size;
-
-			count_code_units_utf() : needed_size(0) {
-			}
-
-			void operator()(const unicode::encoded_result<Ch> er) {
-				needed_size += er.code_units_size;
-			}
-		};
-
-		template <typename Ch, typename ErCh>
-		struct copy_code_units_utf {
-			Ch* target_;
-
-			copy_code_units_utf(Ch* target) : target_(target) {
-			}
-
-			void operator()(const unicode::encoded_result<ErCh> er) {
-				std::memcpy(target_, er.code_units.data(), er.code_units_size * sizeof(ErCh));
-				target_ += er.code_units_size;
-			}
-		};
-
-		template <typename Ch, typename F>
-		inline void convert(const char* strb, const char* stre, F&& f) {
-			char32_t cp = 0;
-			for (const char* strtarget = strb; strtarget < stre;) {
-				auto dr = unicode::utf8_to_code_point(strtarget, stre);
-				if (dr.error != unicode::error_code::ok) {
-					cp = unicode::unicode_detail::replacement;
-					++strtarget;
-				}
-				else {
-					cp = dr.codepoint;
-					strtarget = dr.next;
-				}
-				if constexpr (std::is_same_v<Ch, char32_t>) {
-					auto er = unicode::code_point_to_utf32(cp);
-					f(er);
-				}
-				else {
-					auto er = unicode::code_point_to_utf16(cp);
-					f(er);
-				}
-			}
-		}
-
 		template <typename BaseCh, typename S>
 		inline S get_into(lua_State* L, int index, record& tracking) {
 			using Ch = typename S::value_type;
@@ -103,13 +54,11 @@ namespace sol { namespace stack {
 				return S();
 			const char* strb = utf8p;
 			const char* stre = utf8p + len;
-			stack_detail::count_code_units_utf<BaseCh> count_units;
-			convert<BaseCh>(strb, stre, count_units);
-			S r(count_units.needed_size, static_cast<Ch>(0));
-			r.resize(count_units.needed_size);
+			std::size_t needed_size = unicode::transcoded_size_from_utf8<BaseCh>(strb, stre);
+			S r(needed_size, static_cast<Ch>(0));
+			r.resize(needed_size);
 			Ch* target = &r[0];
-			stack_detail::copy_code_units_utf<Ch, BaseCh> copy_units(target);
-			convert<BaseCh>(strb, stre, copy_units);
+			unicode::transcode_from_utf8(strb, stre, target);
 			return r;
 		}
 	} // namespace stack_detail
@@ -215,16 +164,18 @@ namespace sol { namespace stack {
 					memory = detail::align_usertype_unique_tag<true, false>(memory);
 					detail::unique_tag& ic = *reinterpret_cast<detail::unique_tag*>(memory);
 					memory = detail::align_usertype_unique<actual, true, false>(memory);
+					std::uint64_t ti_id = usertype_traits<element>::type_id();
 					string_view ti = usertype_traits<element>::qualified_name();
 					int cast_operation;
 					if constexpr (is_actual_type_rebindable_for_v<Tu>) {
 						using rebound_actual_type = unique_usertype_rebind_actual_t<Tu, void>;
+						std::uint64_t rebind_ti_id = usertype_traits<rebound_actual_type>::type_id();
 						string_view rebind_ti = usertype_traits<rebound_actual_type>::qualified_name();
-						cast_operation = ic(memory, &r, ti, rebind_ti);
+						cast_operation = ic(memory, &r, ti_id, ti, rebind_ti_id, rebind_ti);
 					}
 					else {
 						string_view rebind_ti("");
-						cast_operation = ic(memory, &r, ti, rebind_ti);
+						cast_operation = ic(memory, &r, ti_id, ti, 0, rebind_ti);
 					}
 					switch (cast_operation) {
 					case 1: {
@@ -280,6 +231,77 @@ namespace sol { namespace stack {
 			cont[idx] = stack::get<V>(L, -lua_size<V>::value);
 		}
 
+#if SOL_LUA_VESION_I_ >= 503
+		template <typename V>
+		static V get_sequence_number(lua_State* L) {
+			if constexpr (std::is_floating_point_v<V>) {
+				return static_cast<V>(lua_tonumber(L, -1));
+			}
+			else {
+				if (lua_isinteger(L, -1) != 0) {
+					return static_cast<V>(lua_tointeger(L, -1));
+				}
+				return static_cast<V>(llround(lua_tonumber(L, -1)));
+			}
+		}
+
+		template <typename V>
+		static void store_sequence_value(T& cont, std::size_t idx, V&& value) {
+			if constexpr (meta::has_push_back<Tu>::value) {
+				(void)idx;
+				cont.push_back(std::forward<V>(value));
+			}
+			else {
+				cont[idx] = std::forward<V>(value);
+			}
+		}
+
+		// a table without a metatable reads the same with or without metamethods,
+		// so it can be sized once with lua_rawlen and walked with lua_rawgeti;
+		// fixed-size containers (std::array and the like) are filled in place up to their max_size
+		template <typename V>
+		static bool get_sequence(lua_State* L, int index, T& cont) {
+#if SOL_IS_ON(SOL_SAFE_STACK_CHECK_I_)
+			luaL_checkstack(L, 1, detail::not_enough_stack_space_generic);
+#endif // make sure stack doesn't overflow
+			if (lua_type(L, index) != LUA_TTABLE) {
+				return false;
+			}
+			if (lua_getmetatable(L, index) != 0) {
+				lua_pop(L, 1);
+				return false;
+			}
+			if constexpr (meta::has_reserve<Tu>::value) {
+				cont.reserve(static_cast<typename Tu::size_type>(lua_rawlen(L, index)));
+			}
+			std::size_t idx = 0;
+			for (lua_Integer i = 0;; ++i) {
+				if constexpr (!meta::has_push_back<Tu>::value) {
+					if (idx >= cont.max_size()) {
+						break;
+					}
+				}
+				type vt = static_cast<type>(lua_rawgeti(L, index, i));
+				if (vt == type::lua_nil || vt == type::none) {
+					lua_pop(L, 1);
+					if (i == 0) {
+						continue;
+					}
+					break;
+				}
+				if constexpr (stack_detail::is_plain_number_v<V> && !meta::meta_detail::is_adl_sol_lua_get_v<V>) {
+					store_sequence_value(cont, idx, get_sequence_number<V>(L));
+				}
+				else {
+					store_sequence_value(cont, idx, stack::get<V>(L, -1));
+				}
+				++idx;
+				lua_pop(L, 1);
+			}
+			return true;
+		}
+#endif
+
 		static bool max_size_check(std::false_type, T&, std::size_t) {
 			return false;
 		}
@@ -339,6 +361,14 @@ namespace sol { namespace stack {
 			T cont;
 			std::size_t idx = 0;
 #if SOL_LUA_VESION_I_ >= 503
+#if SOL_IS_OFF(SOL_LUA_NIL_IN_TABLES_I_) || SOL_LUA_VESION_I_ < 600
+			if constexpr (lua_size<V>::value == 1
+				&& (meta::has_push_back<Tu>::value || (!meta::has_insert<Tu>::value && meta::has_max_size<Tu>::value))) {
+				if (get_sequence<V>(L, index, cont)) {
+					return cont;
+				}
+			}
+#endif
 			// This method is HIGHLY performant over regular table iteration
 			// thanks to the Lua API changes in 5.3
 			// Questionable in 5.4
@@ -899,7 +929,7 @@ namespace sol { namespace stack {
 						void* basecastdata = lua_touserdata(L, -1);
 						detail::inheritance_cast_function ic = reinterpret_cast<detail::inheritance_cast_function>(basecastdata);
 						// use the casting function to properly adjust the pointer for the desired T
-						udata = ic(udata, usertype_traits<T>::qualified_name());
+						udata = ic(udata, usertype_traits<T>::type_id(), usertype_traits<T>::qualified_name());
 					}
 					lua_pop(L, 2);
 				}
@@ -32,6 +32,7 @@
 #include <sol/unicode.hpp>
 
 #include <memory>
+#include <algorithm>
 #include <type_traits>
 #include <cassert>
 #include <limits>
@@ -43,9 +44,12 @@
 
 namespace sol { namespace stack {
 	namespace stack_detail {
+		template <typename T>
+		inline constexpr bool integer_always_fits_v = sizeof(T) < sizeof(lua_Integer) || (std::is_signed_v<T> && sizeof(T) == sizeof(lua_Integer));
+
 		template <typename T>
 		inline bool integer_value_fits(const T& value) {
-			if constexpr (sizeof(T) < sizeof(lua_Integer) || (std::is_signed_v<T> && sizeof(T) == sizeof(lua_Integer))) {
+			if constexpr (integer_always_fits_v<T>) {
 				(void)value;
 				return true;
 			}
@@ -58,6 +62,101 @@ namespace sol { namespace stack {
 			}
 		}
 
+		template <typename T>
+		inline bool integer_value_survives_number(const T& value) {
+			return static_cast<T>(llround(static_cast<lua_Number>(value))) == value;
+		}
+
+		// an ADL sol_lua_push takes precedence over the plain number push
+		template <typename T>
+		inline constexpr bool is_plain_number_push_v = is_plain_number_v<T> && !meta::meta_detail::is_adl_sol_lua_push_exact_v<T, const T&>
+			&& !meta::meta_detail::is_adl_sol_lua_push_v<const T&>;
+
+		inline void create_table(lua_State* L, const new_table& size_hint) {
+			lua_createtable(L, (std::max)(size_hint.sequence_hint, 0), (std::max)(size_hint.map_hint, 0));
+		}
+
+		inline void number_sequence_precision_error() {
+#if SOL_IS_OFF(SOL_EXCEPTIONS_I_)
+			assert(false && "integer value will be misrepresented in lua");
+#else
+			throw error(detail::direct_error, "integer value will be misrepresented in lua");
+#endif // No Exceptions
+		}
+
+		template <typename Range>
+		void check_number_sequence_precision(const Range& range) {
+			using std::begin;
+			using V = meta::unqualified_t<decltype(*begin(range))>;
+#if SOL_LUA_VESION_I_ >= 503
+			if constexpr (!integer_always_fits_v<V>) {
+				// one branch-free pass decides whether anything will go through lua_pushnumber at all;
+				// the llround round trip only runs when some value is out of lua_Integer's range
+				bool all_fit = true;
+				for (const V& value : range) {
+					all_fit &= integer_value_fits<V>(value);
+				}
+				if (all_fit) {
+					return;
+				}
+				for (const V& value : range) {
+					if (!integer_value_fits<V>(value) && !integer_value_survives_number<V>(value)) {
+						number_sequence_precision_error();
+						return;
+					}
+				}
+			}
+#else
+			if constexpr (std::numeric_limits<V>::digits > std::numeric_limits<lua_Number>::digits) {
+				for (const V& value : range) {
+					if (!integer_value_survives_number<V>(value)) {
+						number_sequence_precision_error();
+						return;
+					}
+				}
+			}
+#endif // Lua 5.3 and above
+		}
+
+		// pushes a sequence of plain numbers into a new table with a raw set per element,
+		// skipping the per-element pusher dispatch; precision is checked for the whole
+		// range before the table is created
+		template <typename Range>
+		int push_number_sequence(lua_State* L, const Range& range, const new_table& size_hint) {
+			using std::begin;
+			using V = meta::unqualified_t<decltype(*begin(range))>;
+#if SOL_IS_ON(SOL_NUMBER_PRECISION_CHECKS_I_)
+			if constexpr (std::is_integral_v<V>) {
+				check_number_sequence_precision(range);
+			}
+#endif // Number Precision Check
+#if SOL_IS_ON(SOL_SAFE_STACK_CHECK_I_)
+			luaL_checkstack(L, 2, detail::not_enough_stack_space_generic);
+#endif // make sure stack doesn't overflow
+			create_table(L, size_hint);
+			int tableindex = lua_gettop(L);
+			lua_Integer index = 1;
+			for (const V& value : range) {
+#if SOL_LUA_VESION_I_ >= 503
+				if constexpr (std::is_integral_v<V>) {
+					if (integer_value_fits<V>(value)) {
+						lua_pushinteger(L, static_cast<lua_Integer>(value));
+					}
+					else {
+						lua_pushnumber(L, static_cast<lua_Number>(value));
+					}
+				}
+				else {
+					lua_pushnumber(L, static_cast<lua_Number>(value));
+				}
+#else
+				lua_pushnumber(L, static_cast<lua_Number>(value));
+#endif // Lua 5.3 and above
+				lua_rawseti(L, tableindex, index++);
+			}
+			return 1;
+		}
+
 		template <typename T>
 		int msvc_is_ass_with_if_constexpr_push_enum(std::true_type, lua_State* L, const T& value) {
 			if constexpr (meta::any_same_v<std::underlying_type_t<T>, char /*, char8_t*/, char16_t, char32_t>) {
@@ -116,14 +215,16 @@ namespace sol { namespace stack {
        // just the sizeof(T*), and nothing else.
 			T* obj = detail::usertype_allocate<T>(L);
 			f();
+			detail::usertype_construct_guard<T> guard(L, -1, obj);
 			std::allocator<T> alloc {};
 			std::allocator_traits<std::allocator<T>>::construct(alloc, obj, std::forward<Args>(args)...);
+			guard.release();
 			return 1;
 		}
 
 		template <typename K, typename... Args>
 		static int push_keyed(lua_State* L, K&& k, Args&&... args) {
-			stack_detail::undefined_metatable fx(L, &k[0], &stack::stack_detail::set_undefined_methods_on<T>);
+			stack_detail::undefined_metatable fx(L, stack_detail::usertype_cache_key<T>(), &k[0], &stack::stack_detail::set_undefined_methods_on<T>);
 			return push_fx(L, fx, std::forward<Args>(args)...);
 		}
 
@@ -162,7 +263,7 @@ namespace sol { namespace stack {
 
 		template <typename K>
 		static int push_keyed(lua_State* L, K&& k, T* obj) {
-			stack_detail::undefined_metatable fx(L, &k[0], &stack::stack_detail::set_undefined_methods_on<U*>);
+			stack_detail::undefined_metatable fx(L, stack_detail::usertype_cache_key<U*>(), &k[0], &stack::stack_detail::set_undefined_methods_on<U*>);
 			return push_fx(L, fx, obj);
 		}
 
@@ -214,7 +315,8 @@ namespace sol { namespace stack {
 				detail::unique_destructor* fx = nullptr;
 				detail::unique_tag* id = nullptr;
 				actual* typed_memory = detail::usertype_unique_allocate<element, actual>(L, pointer_to_memory, fx, id);
-				if (luaL_newmetatable(L, &usertype_traits<d::u<std::remove_cv_t<element>>>::metatable()[0]) == 1) {
+				using u_element = d::u<std::remove_cv_t<element>>;
+				if (stack_detail::new_usertype_metatable(L, usertype_cache_key<u_element>(), &usertype_traits<u_element>::metatable()[0]) == 1) {
 					detail::lua_reg_table registration_table {};
 					int index = 0;
 					detail::indexed_insert insert_callable(registration_table, index);
@@ -271,7 +373,7 @@ namespace sol { namespace stack {
 				}
 #endif // Lua 5.3 and above
 #if SOL_IS_ON(SOL_NUMBER_PRECISION_CHECKS_I_)
-				if (static_cast<T>(llround(static_cast<lua_Number>(value))) != value) {
+				if (!stack_detail::integer_value_survives_number<Tu>(value)) {
 #if SOL_IS_OFF(SOL_EXCEPTIONS_I_)
 					// Is this really worth it?
 					assert(false && "integer value will be misrepresented in lua");
@@ -336,26 +438,55 @@ namespace sol { namespace stack {
 	struct unqualified_pusher<detail::as_table_tag<T>> {
 		using has_kvp = meta::has_key_value_pair<meta::unqualified_t<std::remove_pointer_t<T>>>;
 
+		static new_table size_hint_of(const T& tablecont) {
+			auto& cont = detail::deref(detail::unwrap(tablecont));
+			int size = stack_detail::get_size_hint(cont);
+			if constexpr (has_kvp::value) {
+				using value_type = typename meta::unqualified_t<decltype(cont)>::value_type;
+				using key_type = meta::unqualified_t<decltype(std::declval<value_type&>().first)>;
+				// integer keys are likely a sequence and land in the array part;
+				// everything else goes to the hash part, which is otherwise grown
+				// (and rehashed) one power of two at a time as keys are inserted
+				if constexpr (std::is_integral_v<key_type>) {
+					return new_table(size, 0);
+				}
+				else {
+					return new_table(0, size);
+				}
+			}
+			else {
+				return new_table(size, 0);
+			}
+		}
+
 		static int push(lua_State* L, const T& tablecont) {
-			return push(has_kvp(), std::false_type(), L, tablecont);
+			return push(has_kvp(), std::false_type(), L, tablecont, size_hint_of(tablecont));
 		}
 
 		static int push(lua_State* L, const T& tablecont, nested_tag_t) {
-			return push(has_kvp(), std::true_type(), L, tablecont);
+			return push(has_kvp(), std::true_type(), L, tablecont, size_hint_of(tablecont));
+		}
+
+		static int push(lua_State* L, const T& tablecont, const new_table& size_hint) {
+			return push(has_kvp(), std::false_type(), L, tablecont, size_hint);
+		}
+
+		static int push(lua_State* L, const T& tablecont, nested_tag_t, const new_table& size_hint) {
+			return push(has_kvp(), std::true_type(), L, tablecont, size_hint);
 		}
 
 		static int push(std::true_type, lua_State* L, const T& tablecont) {
-			return push(has_kvp(), std::true_type(), L, tablecont);
+			return push(has_kvp(), std::true_type(), L, tablecont, size_hint_of(tablecont));
 		}
 
 		static int push(std::false_type, lua_State* L, const T& tablecont) {
-			return push(has_kvp(), std::false_type(), L, tablecont);
+			return push(has_kvp(), std::false_type(), L, tablecont, size_hint_of(tablecont));
 		}
 
 		template <bool is_nested>
-		static int push(std::true_type, std::integral_constant<bool, is_nested>, lua_State* L, const T& tablecont) {
+		static int push(std::true_type, std::integral_constant<bool, is_nested>, lua_State* L, const T& tablecont, const new_table& size_hint) {
 			auto& cont = detail::deref(detail::unwrap(tablecont));
-			lua_createtable(L, static_cast<int>(cont.size()), 0);
+			stack_detail::create_table(L, size_hint);
 			int tableindex = lua_gettop(L);
 			for (const auto& pair : cont) {
 				if (is_nested) {
@@ -369,9 +500,13 @@ namespace sol { namespace stack {
 		}
 
 		template <bool is_nested>
-		static int push(std::false_type, std::integral_constant<bool, is_nested>, lua_State* L, const T& tablecont) {
+		static int push(std::false_type, std::integral_constant<bool, is_nested>, lua_State* L, const T& tablecont, const new_table& size_hint) {
+			using std::begin;
 			auto& cont = detail::deref(detail::unwrap(tablecont));
-			lua_createtable(L, stack_detail::get_size_hint(cont), 0);
+			if constexpr (stack_detail::is_plain_number_push_v<meta::unqualified_t<decltype(*begin(cont))>>) {
+				return stack_detail::push_number_sequence(L, cont, size_hint);
+			}
+			stack_detail::create_table(L, size_hint);
 			int tableindex = lua_gettop(L);
 			std::size_t index = 1;
 			for (const auto& i : cont) {
@@ -417,6 +552,9 @@ namespace sol { namespace stack {
 		static int push(lua_State* L, const as_table_t<T>& value_) {
 			using inner_t = std::remove_pointer_t<meta::unwrap_unqualified_t<T>>;
 			if constexpr (is_container_v<inner_t>) {
+				if (value_.has_size_hint()) {
+					return stack::push<detail::as_table_tag<T>>(L, value_.value(), value_.size_hint());
+				}
 				return stack::push<detail::as_table_tag<T>>(L, value_.value());
 			}
 			else {
@@ -452,6 +590,9 @@ namespace sol { namespace stack {
 			using Tu = meta::unwrap_unqualified_t<T>;
 			using inner_t = std::remove_pointer_t<Tu>;
 			if constexpr (is_container_v<inner_t>) {
+				if (nested_wrapper_.has_size_hint()) {
+					return stack::push<detail::as_table_tag<T>>(L, nested_wrapper_.value(), nested_tag, nested_wrapper_.size_hint());
+				}
 				return stack::push<detail::as_table_tag<T>>(L, nested_wrapper_.value(), nested_tag);
 			}
 			else {
@@ -903,23 +1044,7 @@ namespace sol { namespace stack {
 	template <>
 	struct unqualified_pusher<const char16_t*> {
 		static int convert_into(lua_State* L, char* start, std::size_t, const char16_t* strb, const char16_t* stre) {
-			char* target = start;
-			char32_t cp = 0;
-			for (const char16_t* strtarget = strb; strtarget < stre;) {
-				auto dr = unicode::utf16_to_code_point(strtarget, stre);
-				if (dr.error != unicode::error_code::ok) {
-					cp = unicode::unicode_detail::replacement;
-				}
-				else {
-					cp = dr.codepoint;
-				}
-				auto er = unicode::code_point_to_utf8(cp);
-				const char* utf8data = er.code_units.data();
-				std::memcpy(target, utf8data, er.code_units_size);
-				target += er.code_units_size;
-				strtarget = dr.next;
-			}
-
+			char* target = unicode::transcode_to_utf8(strb, stre, start);
 			return stack::push(L, start, target);
 		}
 
@@ -940,13 +1065,7 @@ namespace sol { namespace stack {
 				return convert_into(L, sbo, max_possible_code_units, strb, stre);
 			}
 			// otherwise, we must manually count/check size
-			std::size_t needed_size = 0;
-			for (const char16_t* strtarget = strb; strtarget < stre;) {
-				auto dr = unicode::utf16_to_code_point(strtarget, stre);
-				auto er = unicode::code_point_to_utf8(dr.codepoint);
-				needed_size += er.code_units_size;
-				strtarget = dr.next;
-			}
+			std::size_t needed_size = unicode::transcoded_size_to_utf8(strb, stre);
 			if (needed_size < SOL_OPTIMIZATION_STRING_CONVERSION_STACK_SIZE_I_) {
 				return convert_into(L, sbo, needed_size, strb, stre);
 			}
@@ -981,22 +1100,7 @@ namespace sol { namespace stack {
 	template <>
 	struct unqualified_pusher<const char32_t*> {
 		static int convert_into(lua_State* L, char* start, std::size_t, const char32_t* strb, const char32_t* stre) {
-			char* target = start;
-			char32_t cp = 0;
-			for (const char32_t* strtarget = strb; strtarget < stre;) {
-				auto dr = unicode::utf32_to_code_point(strtarget, stre);
-				if (dr.error != unicode::error_code::ok) {
-					cp = unicode::unicode_detail::replacement;
-				}
-				else {
-					cp = dr.codepoint;
-				}
-				auto er = unicode::code_point_to_utf8(cp);
-				const char* data = er.code_units.data();
-				std::memcpy(target, data, er.code_units_size);
-				target += er.code_units_size;
-				strtarget = dr.next;
-			}
+			char* target = unicode::transcode_to_utf8(strb, stre, start);
 			return stack::push(L, start, target);
 		}
 
@@ -1017,13 +1121,7 @@ namespace sol { namespace stack {
 				return convert_into(L, sbo, max_possible_code_units, strb, stre);
 			}
 			// otherwise, we must manually count/check size
-			std::size_t needed_size = 0;
-			for (const char32_t* strtarget = strb; strtarget < stre;) {
-				auto dr = unicode::utf32_to_code_point(strtarget, stre);
-				auto er = unicode::code_point_to_utf8(dr.codepoint);
-				needed_size += er.code_units_size;
-				strtarget = dr.next;
-			}
+			std::size_t needed_size = unicode::transcoded_size_to_utf8(strb, stre);
 			if (needed_size < SOL_OPTIMIZATION_STRING_CONVERSION_STACK_SIZE_I_) {
 				return convert_into(L, sbo, needed_size, strb, stre);
 			}
@@ -0,0 +1,274 @@
+// sol3
+
+// The MIT License (MIT)
+
+// Copyright (c) 2013-2020 Rapptz, ThePhD and contributors
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SOL_STATE_POOL_HPP
+#define SOL_STATE_POOL_HPP
+
+#include <sol/state.hpp>
+#include <sol/protected_function.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sol {
+
+	// N independent states, each owned by its own worker thread;
+	// work is handed out through per-worker queues, and idle workers steal from busy ones
+	class state_pool {
+	public:
+		typedef std::function<void(state&)> initializer;
+
+	private:
+		struct task_base {
+			virtual ~task_base() {
+			}
+			virtual void run(state& lua) = 0;
+		};
+
+		template <typename R>
+		struct packaged : task_base {
+			std::packaged_task<R(state&)> work;
+
+			template <typename Fx>
+			packaged(Fx&& fx) : work(std::forward<Fx>(fx)) {
+			}
+
+			void run(state& lua) override {
+				work(lua);
+			}
+		};
+
+		struct work_queue {
+			std::mutex mutex;
+			std::deque<std::unique_ptr<task_base>> tasks;
+		};
+
+		std::vector<std::unique_ptr<work_queue>> m_queues;
+		std::vector<std::thread> m_workers;
+		std::mutex m_mutex;
+		std::condition_variable m_wake;
+		std::condition_variable m_started;
+		std::size_t m_pending;
+		std::size_t m_ready;
+		bool m_stopping;
+		std::exception_ptr m_startup_error;
+		std::atomic<std::size_t> m_next;
+
+		std::unique_ptr<task_base> pop_own(std::size_t index) {
+			work_queue& q = *m_queues[index];
+			std::lock_guard<std::mutex> lock(q.mutex);
+			if (q.tasks.empty()) {
+				return nullptr;
+			}
+			std::unique_ptr<task_base> t = std::move(q.tasks.front());
+			q.tasks.pop_front();
+			return t;
+		}
+
+		std::unique_ptr<task_base> steal(std::size_t thief) {
+			for (std::size_t offset = 1; offset < m_queues.size(); ++offset) {
+				work_queue& q = *m_queues[(thief + offset) % m_queues.size()];
+				std::lock_guard<std::mutex> lock(q.mutex);
+				if (q.tasks.empty()) {
+					continue;
+				}
+				// take from the opposite end to the owner, to keep out of each other's way
+				std::unique_ptr<task_base> t = std::move(q.tasks.back());
+				q.tasks.pop_back();
+				return t;
+			}
+			return nullptr;
+		}
+
+		void enqueue(std::unique_ptr<task_base> t) {
+			std::size_t index = m_next.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+			{
+				// a worker can take the task as soon as it is queued, but its --m_pending
+				// waits for this lock, so the count never drops below zero
+				std::lock_guard<std::mutex> pending_lock(m_mutex);
+				{
+					work_queue& q = *m_queues[index];
+					std::lock_guard<std::mutex> lock(q.mutex);
+					q.tasks.push_back(std::move(t));
+				}
+				++m_pending;
+			}
+			m_wake.notify_one();
+		}
+
+		void work(std::size_t index, const initializer& init) {
+			state lua;
+			bool initialized = true;
+#if SOL_IS_ON(SOL_EXCEPTIONS_I_)
+			try {
+				if (init) {
+					init(lua);
+				}
+			}
+			catch (...) {
+				initialized = false;
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if (!m_startup_error) {
+					m_startup_error = std::current_exception();
+				}
+			}
+#else
+			if (init) {
+				init(lua);
+			}
+#endif
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				++m_ready;
+			}
+			m_started.notify_all();
+			if (!initialized) {
+				return;
+			}
+			for (;;) {
+				std::unique_ptr<task_base> t = pop_own(index);
+				if (t == nullptr) {
+					t = steal(index);
+				}
+				if (t == nullptr) {
+					std::unique_lock<std::mutex> lock(m_mutex);
+					m_wake.wait(lock, [this]() { return m_stopping || m_pending > 0; });
+					if (m_stopping && m_pending == 0) {
+						return;
+					}
+					continue;
+				}
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					--m_pending;
+				}
+				t->run(lua);
+			}
+		}
+
+		void stop() {
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_stopping = true;
+			}
+			m_wake.notify_all();
+			for (std::thread& worker : m_workers) {
+				worker.join();
+			}
+			m_workers.clear();
+		}
+
+	public:
+		// creates `worker_count` workers (one per hardware thread when 0), each running `init` on its own fresh state;
+		// returns once every state is initialized, and rethrows the first exception an initializer threw
+		explicit state_pool(std::size_t worker_count = 0, initializer init = initializer())
+		: m_queues(), m_workers(), m_mutex(), m_wake(), m_started(), m_pending(0), m_ready(0), m_stopping(false), m_startup_error(), m_next(0) {
+			if (worker_count == 0) {
+				worker_count = (std::max)(static_cast<std::size_t>(std::thread::hardware_concurrency()), static_cast<std::size_t>(1));
+			}
+			m_queues.reserve(worker_count);
+			for (std::size_t i = 0; i < worker_count; ++i) {
+				m_queues.push_back(std::make_unique<work_queue>());
+			}
+			auto shared_init = std::make_shared<const initializer>(std::move(init));
+			m_workers.reserve(worker_count);
+			for (std::size_t i = 0; i < worker_count; ++i) {
+				m_workers.emplace_back([this, i, shared_init]() { work(i, *shared_init); });
+			}
+			std::exception_ptr startup_error;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_started.wait(lock, [this, worker_count]() { return m_ready == worker_count; });
+				startup_error = m_startup_error;
+			}
+			if (startup_error) {
+				stop();
+				std::rethrow_exception(startup_error);
+			}
+		}
+
+		state_pool(const state_pool&) = delete;
+		state_pool(state_pool&&) = delete;
+		state_pool& operator=(const state_pool&) = delete;
+		state_pool& operator=(state_pool&&) = delete;
+
+		// runs every task that was already submitted, then joins the workers
+		~state_pool() {
+			stop();
+		}
+
+		std::size_t size() const noexcept {
+			return m_queues.size();
+		}
+
+		// runs fx(state&) on whichever worker gets to it first
+		template <typename Fx>
+		auto submit(Fx&& fx) {
+			typedef std::invoke_result_t<std::decay_t<Fx>&, state&> R;
+			auto t = std::make_unique<packaged<R>>(std::forward<Fx>(fx));
+			std::future<R> result = t->work.get_future();
+			enqueue(std::move(t));
+			return result;
+		}
+
+		// calls the global function `function_name` with copies of `args`, and converts its result to R;
+		// Lua errors come out of the future as sol::error
+		template <typename R = void, typename... Args>
+		std::future<R> call(std::string function_name, Args&&... args) {
+			static_assert(!is_lua_reference<meta::unqualified_t<R>>::value && !is_stack_based<meta::unqualified_t<R>>::value,
+			     "the result of a state_pool call outlives the call and is read on another thread: it must be a plain C++ value, not a reference into Lua");
+			return submit([name = std::move(function_name), arguments = std::make_tuple(std::decay_t<Args>(std::forward<Args>(args))...)](state& lua) -> R {
+				protected_function fx = lua.globals().get<protected_function>(name);
+				protected_function_result result = std::apply([&fx](const auto&... a) { return fx(a...); }, arguments);
+				if (!result.valid()) {
+					error err = result;
+#if SOL_IS_ON(SOL_EXCEPTIONS_I_)
+					throw err;
+#else
+					(void)err;
+					std::terminate();
+#endif
+				}
+				if constexpr (!std::is_void_v<R>) {
+					return result.get<R>();
+				}
+			});
+		}
+	};
+
+} // namespace sol
+
+#endif // SOL_STATE_POOL_HPP
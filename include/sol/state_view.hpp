@@ -332,7 +332,7 @@ namespace sol {
 
 		template <typename E>
 		protected_function_result do_file(const std::string& filename, const basic_environment<E>& env, load_mode mode = load_mode::any) {
-			load_status x = static_cast<load_status>(luaL_loadfilex(L, filename.c_str(), to_string(mode).c_str()));
+			load_status x = static_cast<load_status>(stack::load_file(L, filename, mode));
 			if (x != load_status::ok) {
 				return protected_function_result(L, absolute_index(L, -1), 0, 1, static_cast<call_status>(x));
 			}
@@ -342,7 +342,7 @@ namespace sol {
 		}
 
 		protected_function_result do_file(const std::string& filename, load_mode mode = load_mode::any) {
-			load_status x = static_cast<load_status>(luaL_loadfilex(L, filename.c_str(), to_string(mode).c_str()));
+			load_status x = static_cast<load_status>(stack::load_file(L, filename, mode));
 			if (x != load_status::ok) {
 				return protected_function_result(L, absolute_index(L, -1), 0, 1, static_cast<call_status>(x));
 			}
@@ -487,7 +487,7 @@ namespace sol {
 		template <typename E>
 		unsafe_function_result unsafe_script_file(const std::string& filename, const basic_environment<E>& env, load_mode mode = load_mode::any) {
 			int index = lua_gettop(L);
-			if (luaL_loadfilex(L, filename.c_str(), to_string(mode).c_str())) {
+			if (stack::load_file(L, filename, mode)) {
 				lua_error(L);
 			}
 			set_environment(env, stack_reference(L, raw_index(index + 1)));
@@ -582,7 +582,7 @@ namespace sol {
 		}
 
 		load_result load_file(const std::string& filename, load_mode mode = load_mode::any) {
-			load_status x = static_cast<load_status>(luaL_loadfilex(L, filename.c_str(), to_string(mode).c_str()));
+			load_status x = static_cast<load_status>(stack::load_file(L, filename, mode));
 			return load_result(L, absolute_index(L, -1), 1, 1, x);
 		}
 
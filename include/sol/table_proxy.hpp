@@ -74,7 +74,7 @@ namespace sol {
 		key_type key;
 
 		template <typename T>
-		table_proxy(Table table, T&& k) : tbl(table), key(std::forward<T>(k)) {
+		table_proxy(Table table, T&& k) : tbl(std::forward<Table>(table)), key(std::forward<T>(k)) {
 		}
 
 		template <typename T>
@@ -192,8 +192,10 @@ namespace sol {
 
 		template <typename K>
 		decltype(auto) operator[](K&& k) && {
+			// a borrowed table stays borrowed; an owned one moves
+			// down the chain instead of taking another registry reference
 			auto keys = meta::tuplefy(std::move(key), std::forward<K>(k));
-			return table_proxy<Table, decltype(keys)>(tbl, std::move(keys));
+			return table_proxy<Table, decltype(keys)>(std::forward<Table>(tbl), std::move(keys));
 		}
 
 		template <typename... Ret, typename... Args>
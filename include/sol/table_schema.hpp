@@ -0,0 +1,232 @@
+// sol3
+
+// The MIT License (MIT)
+
+// Copyright (c) 2013-2020 Rapptz, ThePhD and contributors
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SOL_TABLE_SCHEMA_HPP
+#define SOL_TABLE_SCHEMA_HPP
+
+#include <sol/stack.hpp>
+#include <sol/reference.hpp>
+#include <sol/table.hpp>
+
+#include <vector>
+#include <type_traits>
+#include <utility>
+
+namespace sol {
+
+	namespace detail {
+		template <typename T>
+		struct table_schema_value {
+			const table_schema<T>& schema;
+			const T& value;
+		};
+
+		template <typename T>
+		struct lua_type_of<table_schema_value<T>> : std::integral_constant<type, type::table> { };
+	} // namespace detail
+
+	// the data members of T, each paired once with a key kept in the registry,
+	// so a whole T goes to or comes from a Lua table in a single pass
+	template <typename T>
+	class table_schema {
+	private:
+		// any pointer to data member of T survives a round trip through char T::*
+		using member_slot = char T::*;
+		using push_function = void (*)(lua_State*, const T&, member_slot);
+		using get_function = void (*)(lua_State*, int, T&, member_slot);
+
+		struct field {
+			stateless_reference key;
+			member_slot member;
+			push_function push;
+			get_function get;
+		};
+
+		lua_State* m_L = nullptr;
+		std::vector<field> m_fields;
+
+		template <typename M>
+		static void push_member(lua_State* L, const T& value, member_slot member) {
+			stack::push(L, value.*reinterpret_cast<M T::*>(member));
+		}
+
+		template <typename M>
+		static void get_member(lua_State* L, int index, T& value, member_slot member) {
+			value.*reinterpret_cast<M T::*>(member) = stack::get<M>(L, index);
+		}
+
+		template <typename Key, typename M, typename C>
+		void add_field(lua_State* L, Key&& key, M C::*member) {
+			static_assert(std::is_member_object_pointer_v<M C::*>, "a table_schema can only be made from pointers to data members");
+			static_assert(std::is_base_of_v<C, T>, "a table_schema member must belong to T or one of its bases");
+			M T::*typed_member = member;
+			stack::push(L, std::forward<Key>(key));
+			m_fields.push_back(field { stateless_reference(L, -1), reinterpret_cast<member_slot>(typed_member), &push_member<M>, &get_member<M> });
+			lua_pop(L, 1);
+		}
+
+		template <typename Key, typename Member, typename... Args>
+		void add_fields(lua_State* L, Key&& key, Member member, Args&&... args) {
+			add_field(L, std::forward<Key>(key), member);
+			if constexpr (sizeof...(Args) > 0) {
+				add_fields(L, std::forward<Args>(args)...);
+			}
+		}
+
+		void release() noexcept {
+			for (field& f : m_fields) {
+				f.key.deref(m_L);
+			}
+			m_fields.clear();
+		}
+
+	public:
+		template <typename... Args>
+		table_schema(lua_State* L, Args&&... keys_and_members) : m_L(main_thread(L, L)) {
+			static_assert(sizeof...(Args) % 2 == 0, "a table_schema is made from key, member pointer pairs");
+			m_fields.reserve(sizeof...(Args) / 2);
+			if constexpr (sizeof...(Args) > 0) {
+				add_fields(L, std::forward<Args>(keys_and_members)...);
+			}
+		}
+
+		table_schema(const table_schema&) = delete;
+		table_schema& operator=(const table_schema&) = delete;
+
+		table_schema(table_schema&& other) noexcept : m_L(std::exchange(other.m_L, nullptr)), m_fields(std::move(other.m_fields)) {
+			other.m_fields.clear();
+		}
+
+		table_schema& operator=(table_schema&& other) noexcept {
+			if (this != &other) {
+				release();
+				m_L = std::exchange(other.m_L, nullptr);
+				m_fields = std::move(other.m_fields);
+				other.m_fields.clear();
+			}
+			return *this;
+		}
+
+		~table_schema() {
+			release();
+		}
+
+		lua_State* lua_state() const noexcept {
+			return m_L;
+		}
+
+		std::size_t size() const noexcept {
+			return m_fields.size();
+		}
+
+		int push(lua_State* L, const T& value) const {
+#if SOL_IS_ON(SOL_SAFE_STACK_CHECK_I_)
+			luaL_checkstack(L, 3, detail::not_enough_stack_space_generic);
+#endif // make sure stack doesn't overflow
+			lua_createtable(L, 0, static_cast<int>(m_fields.size()));
+			for (const field& f : m_fields) {
+				f.key.push(L);
+				f.push(L, value, f.member);
+				lua_rawset(L, -3);
+			}
+			return 1;
+		}
+
+		table create(lua_State* L, const T& value) const {
+			push(L, value);
+			return stack::pop<table>(L);
+		}
+
+		// pushes as a freshly made table when passed to Lua, without a reference in between
+		detail::table_schema_value<T> to_lua(const T& value) const noexcept {
+			return { *this, value };
+		}
+
+		void write(lua_State* L, int index, const T& value) const {
+#if SOL_IS_ON(SOL_SAFE_STACK_CHECK_I_)
+			luaL_checkstack(L, 2, detail::not_enough_stack_space_generic);
+#endif // make sure stack doesn't overflow
+			index = lua_absindex(L, index);
+			for (const field& f : m_fields) {
+				f.key.push(L);
+				f.push(L, value, f.member);
+				lua_settable(L, index);
+			}
+		}
+
+		template <typename Ref>
+		void write(const basic_table_core<false, Ref>& target, const T& value) const {
+			lua_State* L = target.lua_state();
+			auto pp = stack::push_pop(target);
+			write(L, -1, value);
+		}
+
+		// members whose key is nil in the table are left as they are
+		void read(lua_State* L, int index, T& value) const {
+#if SOL_IS_ON(SOL_SAFE_STACK_CHECK_I_)
+			luaL_checkstack(L, 1, detail::not_enough_stack_space_generic);
+#endif // make sure stack doesn't overflow
+			index = lua_absindex(L, index);
+			for (const field& f : m_fields) {
+				f.key.push(L);
+				lua_gettable(L, index);
+				if (!lua_isnil(L, -1)) {
+					f.get(L, lua_gettop(L), value, f.member);
+				}
+				lua_pop(L, 1);
+			}
+		}
+
+		T read(lua_State* L, int index) const {
+			T value {};
+			read(L, index, value);
+			return value;
+		}
+
+		template <typename Ref>
+		void read(const basic_table_core<false, Ref>& source, T& value) const {
+			lua_State* L = source.lua_state();
+			auto pp = stack::push_pop(source);
+			read(L, -1, value);
+		}
+
+		template <typename Ref>
+		T read(const basic_table_core<false, Ref>& source) const {
+			T value {};
+			read(source, value);
+			return value;
+		}
+	};
+
+	namespace stack {
+		template <typename T>
+		struct unqualified_pusher<detail::table_schema_value<T>> {
+			static int push(lua_State* L, const detail::table_schema_value<T>& sv) {
+				return sv.schema.push(L, sv.value);
+			}
+		};
+	} // namespace stack
+
+} // namespace sol
+
+#endif // SOL_TABLE_SCHEMA_HPP
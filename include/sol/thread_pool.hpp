@@ -0,0 +1,147 @@
+// sol3
+
+// The MIT License (MIT)
+
+// Copyright (c) 2013-2020 Rapptz, ThePhD and contributors
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SOL_THREAD_POOL_HPP
+#define SOL_THREAD_POOL_HPP
+
+#include <sol/thread.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace sol {
+
+	struct thread_pool_stats {
+		// acquire() calls served by an idle thread
+		std::size_t hits = 0;
+		// acquire() calls that had to create a thread
+		std::size_t misses = 0;
+		// release() calls that put the thread back into the pool
+		std::size_t recycled = 0;
+		// release() calls that dropped the thread, because it could not be reset or the pool was full
+		std::size_t discarded = 0;
+	};
+
+	namespace detail {
+		// rewinds a finished, failed or suspended thread so it can run a new function;
+		// returns false if that is not possible on this Lua version
+		inline bool reset_thread(lua_State* L, lua_State* from) {
+			lua_Debug ar;
+			if (lua_status(L) == LUA_OK && lua_getstack(L, 0, &ar) > 0) {
+				// currently running
+				return false;
+			}
+#if SOL_LUA_VESION_I_ >= 504
+#if defined(LUA_VERSION_RELEASE_NUM) && LUA_VERSION_RELEASE_NUM >= 50406
+			// the status only reports the error the thread died with, the reset itself always happens
+			(void)lua_closethread(L, from);
+#else
+			(void)from;
+			(void)lua_resetthread(L);
+#endif
+#else
+			(void)from;
+			if (lua_status(L) != LUA_OK) {
+				// before 5.4, a thread that errored or yielded cannot be rewound
+				return false;
+			}
+#endif
+			lua_settop(L, 0);
+			return lua_status(L) == LUA_OK;
+		}
+	} // namespace detail
+
+	class thread_pool {
+	private:
+		lua_State* m_L;
+		std::size_t m_max_size;
+		std::vector<thread> m_idle;
+		thread_pool_stats m_stats;
+
+	public:
+		explicit thread_pool(lua_State* L, std::size_t max_size = 64) : m_L(main_thread(L, L)), m_max_size(max_size), m_idle(), m_stats() {
+			m_idle.reserve(max_size);
+		}
+
+		thread_pool(const thread_pool&) = delete;
+		thread_pool& operator=(const thread_pool&) = delete;
+		thread_pool(thread_pool&&) = default;
+		thread_pool& operator=(thread_pool&&) = default;
+
+		lua_State* lua_state() const noexcept {
+			return m_L;
+		}
+
+		thread acquire() {
+			if (m_idle.empty()) {
+				++m_stats.misses;
+				return thread::create(m_L);
+			}
+			++m_stats.hits;
+			thread t = std::move(m_idle.back());
+			m_idle.pop_back();
+			return t;
+		}
+
+		bool release(const thread& t) {
+			lua_State* thread_L = t.valid() ? t.thread_state() : nullptr;
+			if (thread_L == nullptr || thread_L == m_L || m_idle.size() >= m_max_size || !detail::reset_thread(thread_L, m_L)) {
+				++m_stats.discarded;
+				return false;
+			}
+			++m_stats.recycled;
+			m_idle.push_back(t);
+			return true;
+		}
+
+		std::size_t size() const noexcept {
+			return m_idle.size();
+		}
+
+		std::size_t max_size() const noexcept {
+			return m_max_size;
+		}
+
+		void set_max_size(std::size_t max_size) {
+			m_max_size = max_size;
+			if (m_idle.size() > m_max_size) {
+				m_idle.erase(m_idle.begin() + static_cast<std::ptrdiff_t>(m_max_size), m_idle.end());
+			}
+		}
+
+		void clear() noexcept {
+			m_idle.clear();
+		}
+
+		const thread_pool_stats& stats() const noexcept {
+			return m_stats;
+		}
+
+		void reset_stats() noexcept {
+			m_stats = thread_pool_stats();
+		}
+	};
+
+} // namespace sol
+
+#endif // SOL_THREAD_POOL_HPP
@@ -450,6 +450,18 @@ namespace sol { namespace meta {
 			static constexpr bool value = std::is_same_v<decltype(test<T>(0)), sfinae_yes_t>;
 		};
 
+		template <typename T>
+		struct has_reserve_test {
+		private:
+			template <typename C>
+			static sfinae_yes_t test(decltype(std::declval<C>().reserve(std::declval<typename C::size_type>()))*);
+			template <typename C>
+			static sfinae_no_t test(...);
+
+		public:
+			static constexpr bool value = std::is_same_v<decltype(test<T>(0)), sfinae_yes_t>;
+		};
+
 		template <typename T>
 		struct has_to_string_test {
 		private:
@@ -559,6 +571,9 @@ namespace sol { namespace meta {
 	template <typename T>
 	using has_max_size = meta::boolean<meta_detail::has_max_size_test<T>::value>;
 
+	template <typename T>
+	using has_reserve = meta::boolean<meta_detail::has_reserve_test<T>::value>;
+
 	template <typename T>
 	using has_insert = meta::boolean<meta_detail::has_insert_test<T>::value>;
 
@@ -342,6 +342,20 @@ namespace sol {
 		return function_arguments<Sig, Args...>(std::forward<Args>(args)...);
 	}
 
+	struct new_table {
+		int sequence_hint = 0;
+		int map_hint = 0;
+
+		new_table() = default;
+		new_table(const new_table&) = default;
+		new_table(new_table&&) = default;
+		new_table& operator=(const new_table&) = default;
+		new_table& operator=(new_table&&) = default;
+
+		new_table(int sequence_hint_, int map_hint_ = 0) noexcept : sequence_hint(sequence_hint_), map_hint(map_hint_) {
+		}
+	};
+
 	template <typename T>
 	struct as_table_t : private detail::ebco<T> {
 	private:
@@ -356,8 +370,20 @@ namespace sol {
 
 		using base_t::base_t;
 
+		template <typename Arg>
+		as_table_t(Arg&& arg, const new_table& size_hint_) : base_t(std::forward<Arg>(arg)), m_size_hint(size_hint_), m_has_size_hint(true) {
+		}
+
 		using base_t::value;
 
+		bool has_size_hint() const noexcept {
+			return m_has_size_hint;
+		}
+
+		const new_table& size_hint() const noexcept {
+			return m_size_hint;
+		}
+
 		operator std::add_lvalue_reference_t<T>() {
 			return this->base_t::value();
 		}
@@ -365,6 +391,10 @@ namespace sol {
 		operator std::add_const_t<std::add_lvalue_reference_t<T>>() const {
 			return this->base_t::value();
 		}
+
+	private:
+		new_table m_size_hint;
+		bool m_has_size_hint = false;
 	};
 
 	template <typename T>
@@ -383,8 +413,20 @@ namespace sol {
 
 		using base_t::base_t;
 
+		template <typename Arg>
+		nested(Arg&& arg, const new_table& size_hint_) : base_t(std::forward<Arg>(arg)), m_size_hint(size_hint_), m_has_size_hint(true) {
+		}
+
 		using base_t::value;
 
+		bool has_size_hint() const noexcept {
+			return m_has_size_hint;
+		}
+
+		const new_table& size_hint() const noexcept {
+			return m_size_hint;
+		}
+
 		operator std::add_lvalue_reference_t<T>() {
 			return this->base_t::value();
 		}
@@ -392,6 +434,10 @@ namespace sol {
 		operator std::add_const_t<std::add_lvalue_reference_t<T>>() const {
 			return this->base_t::value();
 		}
+
+	private:
+		new_table m_size_hint;
+		bool m_has_size_hint = false;
 	};
 
 	struct nested_tag_t { };
@@ -407,6 +453,16 @@ namespace sol {
 		return as_table_t<meta::unqualified_t<T>>(std::forward<T>(container));
 	}
 
+	template <typename T>
+	as_table_t<T> as_table_ref(T&& container, const new_table& size_hint) {
+		return as_table_t<T>(std::forward<T>(container), size_hint);
+	}
+
+	template <typename T>
+	as_table_t<meta::unqualified_t<T>> as_table(T&& container, const new_table& size_hint) {
+		return as_table_t<meta::unqualified_t<T>>(std::forward<T>(container), size_hint);
+	}
+
 	template <typename T>
 	nested<T> as_nested_ref(T&& container) {
 		return nested<T>(std::forward<T>(container));
@@ -417,6 +473,16 @@ namespace sol {
 		return nested<meta::unqualified_t<T>>(std::forward<T>(container));
 	}
 
+	template <typename T>
+	nested<T> as_nested_ref(T&& container, const new_table& size_hint) {
+		return nested<T>(std::forward<T>(container), size_hint);
+	}
+
+	template <typename T>
+	nested<meta::unqualified_t<T>> as_nested(T&& container, const new_table& size_hint) {
+		return nested<meta::unqualified_t<T>>(std::forward<T>(container), size_hint);
+	}
+
 	template <typename T>
 	struct as_container_t : private detail::ebco<T> {
 	private:
@@ -545,20 +611,6 @@ namespace sol {
 		}
 	};
 
-	struct new_table {
-		int sequence_hint = 0;
-		int map_hint = 0;
-
-		new_table() = default;
-		new_table(const new_table&) = default;
-		new_table(new_table&&) = default;
-		new_table& operator=(const new_table&) = default;
-		new_table& operator=(new_table&&) = default;
-
-		new_table(int sequence_hint_, int map_hint_ = 0) noexcept : sequence_hint(sequence_hint_), map_hint(map_hint_) {
-		}
-	};
-
 	const new_table create = {};
 
 	enum class lib : unsigned char {
@@ -1033,6 +1085,9 @@ namespace sol {
 		template <typename Signature>
 		struct lua_type_of<std::function<Signature>> : std::integral_constant<type, type::function> { };
 
+		template <typename Signature>
+		struct lua_type_of<lua_callback<Signature>> : std::integral_constant<type, type::function> { };
+
 		template <typename T>
 		struct lua_type_of<optional<T>> : std::integral_constant<type, type::poly> { };
 
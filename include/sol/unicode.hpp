@@ -3,6 +3,13 @@
 #include <sol/string_view.hpp>
 #include <array>
 #include <cstring>
+#include <cstddef>
+
+#if SOL_IS_ON(SOL_UNICODE_SIMD_I_) && SOL_IS_ON(SOL_PLATFORM_AVX2_I_)
+#include <immintrin.h>
+#elif SOL_IS_ON(SOL_UNICODE_SIMD_I_) && SOL_IS_ON(SOL_PLATFORM_SSE2_I_)
+#include <emmintrin.h>
+#endif
 
 namespace sol {
 	// Everything here was lifted pretty much straight out of
@@ -276,6 +283,11 @@ namespace sol {
 			}
 
 			++it;
+			if (it == last) {
+				dr.error = error_code::sequence_too_short;
+				dr.next = it;
+				return dr;
+			}
 			auto trail = *it;
 			if (!unicode_detail::is_trail_surrogate(trail)) {
 				dr.error = error_code::invalid_trailing_surrogate;
@@ -302,5 +314,262 @@ namespace sol {
 			dr.error = error_code::ok;
 			return dr;
 		}
+
+		namespace unicode_ascii_detail {
+			// the leading run of code units below 0x80 is checked (and, if Store, narrowed / widened)
+			// 16 or 32 code units at a time when SSE2 / AVX2 are available; the rest is done one unit at a time
+
+			template <bool Store, typename Ch>
+			inline std::size_t narrow(const Ch* first, const Ch* last, char* out) {
+				static_assert(sizeof(Ch) == 2 || sizeof(Ch) == 4, "narrowing is only for UTF-16 and UTF-32 code units");
+				const Ch* it = first;
+				if constexpr (sizeof(Ch) == 2) {
+#if SOL_IS_ON(SOL_UNICODE_SIMD_I_) && SOL_IS_ON(SOL_PLATFORM_AVX2_I_)
+					const __m256i high_bits_256 = _mm256_set1_epi16(-0x80);
+					for (; last - it >= 32; it += 32) {
+						__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(it));
+						__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(it + 16));
+						if (!_mm256_testz_si256(_mm256_or_si256(a, b), high_bits_256)) {
+							break;
+						}
+						if constexpr (Store) {
+							__m256i bytes = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8);
+							_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), bytes);
+							out += 32;
+						}
+					}
+#endif
+#if SOL_IS_ON(SOL_UNICODE_SIMD_I_) && SOL_IS_ON(SOL_PLATFORM_SSE2_I_)
+					const __m128i high_bits_128 = _mm_set1_epi16(-0x80);
+					for (; last - it >= 16; it += 16) {
+						__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+						__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it + 8));
+						__m128i high = _mm_and_si128(_mm_or_si128(a, b), high_bits_128);
+						if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) != 0xFFFF) {
+							break;
+						}
+						if constexpr (Store) {
+							_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(a, b));
+							out += 16;
+						}
+					}
+#endif
+				}
+				else {
+#if SOL_IS_ON(SOL_UNICODE_SIMD_I_) && SOL_IS_ON(SOL_PLATFORM_AVX2_I_)
+					const __m256i high_bits_256 = _mm256_set1_epi32(-0x80);
+					for (; last - it >= 32; it += 32) {
+						__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(it));
+						__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(it + 8));
+						__m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(it + 16));
+						__m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(it + 24));
+						if (!_mm256_testz_si256(_mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d)), high_bits_256)) {
+							break;
+						}
+						if constexpr (Store) {
+							// pack within 128-bit lanes, then put the 64-bit quarters back in order
+							__m256i ab = _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8);
+							__m256i cd = _mm256_permute4x64_epi64(_mm256_packs_epi32(c, d), 0xD8);
+							__m256i bytes = _mm256_permute4x64_epi64(_mm256_packus_epi16(ab, cd), 0xD8);
+							_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), bytes);
+							out += 32;
+						}
+					}
+#endif
+#if SOL_IS_ON(SOL_UNICODE_SIMD_I_) && SOL_IS_ON(SOL_PLATFORM_SSE2_I_)
+					const __m128i high_bits_128 = _mm_set1_epi32(-0x80);
+					for (; last - it >= 16; it += 16) {
+						__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+						__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it + 4));
+						__m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it + 8));
+						__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it + 12));
+						__m128i high = _mm_and_si128(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)), high_bits_128);
+						if (_mm_movemask_epi8(_mm_cmpeq_epi32(high, _mm_setzero_si128())) != 0xFFFF) {
+							break;
+						}
+						if constexpr (Store) {
+							_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+							out += 16;
+						}
+					}
+#endif
+				}
+				for (; it != last && static_cast<char32_t>(*it) < 0x80; ++it) {
+					if constexpr (Store) {
+						*out++ = static_cast<char>(*it);
+					}
+				}
+				return static_cast<std::size_t>(it - first);
+			}
+
+			template <bool Store, typename OutCh>
+			inline std::size_t widen(const char* first, const char* last, OutCh* out) {
+				static_assert(sizeof(OutCh) == 2 || sizeof(OutCh) == 4, "widening is only for UTF-16 and UTF-32 code units");
+				const char* it = first;
+#if SOL_IS_ON(SOL_UNICODE_SIMD_I_) && SOL_IS_ON(SOL_PLATFORM_AVX2_I_)
+				for (; last - it >= 32; it += 32) {
+					__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(it));
+					if (_mm256_movemask_epi8(v) != 0) {
+						break;
+					}
+					if constexpr (Store) {
+						__m128i lo = _mm256_castsi256_si128(v);
+						__m128i hi = _mm256_extracti128_si256(v, 1);
+						if constexpr (sizeof(OutCh) == 2) {
+							_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_cvtepu8_epi16(lo));
+							_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 16), _mm256_cvtepu8_epi16(hi));
+						}
+						else {
+							_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_cvtepu8_epi32(lo));
+							_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 8), _mm256_cvtepu8_epi32(_mm_srli_si128(lo, 8)));
+							_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 16), _mm256_cvtepu8_epi32(hi));
+							_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 24), _mm256_cvtepu8_epi32(_mm_srli_si128(hi, 8)));
+						}
+						out += 32;
+					}
+				}
+#endif
+#if SOL_IS_ON(SOL_UNICODE_SIMD_I_) && SOL_IS_ON(SOL_PLATFORM_SSE2_I_)
+				for (; last - it >= 16; it += 16) {
+					__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+					if (_mm_movemask_epi8(v) != 0) {
+						break;
+					}
+					if constexpr (Store) {
+						const __m128i zero = _mm_setzero_si128();
+						__m128i lo = _mm_unpacklo_epi8(v, zero);
+						__m128i hi = _mm_unpackhi_epi8(v, zero);
+						if constexpr (sizeof(OutCh) == 2) {
+							_mm_storeu_si128(reinterpret_cast<__m128i*>(out), lo);
+							_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), hi);
+						}
+						else {
+							_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi16(lo, zero));
+							_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_unpackhi_epi16(lo, zero));
+							_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_unpacklo_epi16(hi, zero));
+							_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 12), _mm_unpackhi_epi16(hi, zero));
+						}
+						out += 16;
+					}
+				}
+#endif
+				for (; it != last && static_cast<unsigned char>(*it) < 0x80; ++it) {
+					if constexpr (Store) {
+						*out++ = static_cast<OutCh>(*it);
+					}
+				}
+				return static_cast<std::size_t>(it - first);
+			}
+
+			// decodes one UTF-16 / UTF-32 code point, replacing anything invalid with U+FFFD and skipping one code unit
+			template <typename Ch>
+			inline char32_t decode_or_replace(const Ch*& it, const Ch* last) {
+				decoded_result<const Ch*> dr;
+				if constexpr (sizeof(Ch) == 2) {
+					dr = utf16_to_code_point(it, last);
+				}
+				else {
+					dr = utf32_to_code_point(it, last);
+				}
+				if (dr.error != error_code::ok) {
+					++it;
+					return unicode_detail::replacement;
+				}
+				it = dr.next;
+				return dr.codepoint;
+			}
+
+			inline char32_t decode_or_replace(const char*& it, const char* last) {
+				auto dr = utf8_to_code_point(it, last);
+				if (dr.error != error_code::ok) {
+					++it;
+					return unicode_detail::replacement;
+				}
+				it = dr.next;
+				return dr.codepoint;
+			}
+		} // namespace unicode_ascii_detail
+
+		// number of UTF-8 code units needed to transcode [first, last) from UTF-16 (sizeof(Ch) == 2) or UTF-32 (sizeof(Ch) == 4)
+		template <typename Ch>
+		inline std::size_t transcoded_size_to_utf8(const Ch* first, const Ch* last) {
+			std::size_t size = 0;
+			while (first != last) {
+				std::size_t ascii = unicode_ascii_detail::narrow<false>(first, last, static_cast<char*>(nullptr));
+				size += ascii;
+				first += ascii;
+				if (first == last) {
+					break;
+				}
+				size += code_point_to_utf8(unicode_ascii_detail::decode_or_replace(first, last)).code_units_size;
+			}
+			return size;
+		}
+
+		// transcodes [first, last) from UTF-16 (sizeof(Ch) == 2) or UTF-32 (sizeof(Ch) == 4) into out,
+		// which must have room for transcoded_size_to_utf8(first, last) code units; returns the end of the output
+		template <typename Ch>
+		inline char* transcode_to_utf8(const Ch* first, const Ch* last, char* out) {
+			while (first != last) {
+				std::size_t ascii = unicode_ascii_detail::narrow<true>(first, last, out);
+				first += ascii;
+				out += ascii;
+				if (first == last) {
+					break;
+				}
+				auto er = code_point_to_utf8(unicode_ascii_detail::decode_or_replace(first, last));
+				std::memcpy(out, er.code_units.data(), er.code_units_size);
+				out += er.code_units_size;
+			}
+			return out;
+		}
+
+		// number of UTF-16 (sizeof(Ch) == 2) or UTF-32 (sizeof(Ch) == 4) code units needed to transcode [first, last) from UTF-8
+		template <typename Ch>
+		inline std::size_t transcoded_size_from_utf8(const char* first, const char* last) {
+			std::size_t size = 0;
+			while (first != last) {
+				std::size_t ascii = unicode_ascii_detail::widen<false>(first, last, static_cast<Ch*>(nullptr));
+				size += ascii;
+				first += ascii;
+				if (first == last) {
+					break;
+				}
+				char32_t cp = unicode_ascii_detail::decode_or_replace(first, last);
+				if constexpr (sizeof(Ch) == 2) {
+					size += code_point_to_utf16(cp).code_units_size;
+				}
+				else {
+					(void)cp;
+					size += 1;
+				}
+			}
+			return size;
+		}
+
+		// transcodes [first, last) from UTF-8 into UTF-16 (sizeof(Ch) == 2) or UTF-32 (sizeof(Ch) == 4) code units,
+		// which must have room for transcoded_size_from_utf8<Ch>(first, last) code units; returns the end of the output
+		template <typename Ch>
+		inline Ch* transcode_from_utf8(const char* first, const char* last, Ch* out) {
+			while (first != last) {
+				std::size_t ascii = unicode_ascii_detail::widen<true>(first, last, out);
+				first += ascii;
+				out += ascii;
+				if (first == last) {
+					break;
+				}
+				char32_t cp = unicode_ascii_detail::decode_or_replace(first, last);
+				if constexpr (sizeof(Ch) == 2) {
+					auto er = code_point_to_utf16(cp);
+					for (std::size_t i = 0; i < er.code_units_size; ++i) {
+						*out++ = static_cast<Ch>(er.code_units[i]);
+					}
+				}
+				else {
+					*out++ = static_cast<Ch>(cp);
+				}
+			}
+			return out;
+		}
 	} // namespace unicode
 } // namespace sol
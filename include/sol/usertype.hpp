@@ -82,6 +82,31 @@ namespace sol {
 			}
 		}
 
+		void freeze() {
+			optional<u_detail::usertype_storage<T>&> maybe_uts = u_detail::maybe_get_usertype_storage<T>(this->lua_state());
+			if (maybe_uts) {
+				u_detail::usertype_storage<T>& uts = *maybe_uts;
+				uts.freeze(this->lua_state());
+			}
+		}
+
+		void thaw() {
+			optional<u_detail::usertype_storage<T>&> maybe_uts = u_detail::maybe_get_usertype_storage<T>(this->lua_state());
+			if (maybe_uts) {
+				u_detail::usertype_storage<T>& uts = *maybe_uts;
+				uts.thaw();
+			}
+		}
+
+		bool is_frozen() const {
+			optional<u_detail::usertype_storage<T>&> maybe_uts = u_detail::maybe_get_usertype_storage<T>(this->lua_state());
+			if (maybe_uts) {
+				u_detail::usertype_storage<T>& uts = *maybe_uts;
+				return uts.is_frozen;
+			}
+			return false;
+		}
+
 		template <typename Key>
 		usertype_proxy<basic_usertype&, std::decay_t<Key>> operator[](Key&& key) {
 			return usertype_proxy<basic_usertype&, std::decay_t<Key>>(*this, std::forward<Key>(key));
@@ -0,0 +1,152 @@
+// sol3
+
+// The MIT License (MIT)
+
+// Copyright (c) 2013-2020 Rapptz, ThePhD and contributors
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef SOL_USERTYPE_ALLOCATION_POLICY_HPP
+#define SOL_USERTYPE_ALLOCATION_POLICY_HPP
+
+#include <sol/forward.hpp>
+#include <sol/base_traits.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace sol {
+
+	struct usertype_pool_stats {
+		std::size_t slots_in_use = 0;
+		std::size_t slots_free = 0;
+		std::size_t peak_slots_in_use = 0;
+		std::size_t slabs = 0;
+	};
+
+	// A process-wide, thread-safe free list of fixed-size slots for T, grown one slab at a time.
+	// Slots handed back by __gc are reused by the next push or construction of a T,
+	// so short-lived values stop going through the lua_State's allocator.
+	template <typename T, std::size_t slots_per_slab = 256>
+	class usertype_pool {
+	private:
+		static_assert(slots_per_slab > 0, "a usertype pool slab must hold at least one slot");
+
+		union slot {
+			slot* next;
+			alignas(T) unsigned char storage[sizeof(T)];
+		};
+
+		struct pool_state {
+			std::mutex lock;
+			std::vector<std::unique_ptr<slot[]>> slabs;
+			slot* free_list = nullptr;
+			usertype_pool_stats stats;
+
+			void grow() {
+				std::unique_ptr<slot[]> slab(new slot[slots_per_slab]);
+				for (std::size_t i = slots_per_slab; i-- > 0;) {
+					slab[i].next = free_list;
+					free_list = &slab[i];
+				}
+				slabs.push_back(std::move(slab));
+				stats.slots_free += slots_per_slab;
+				++stats.slabs;
+			}
+		};
+
+		static pool_state& state() {
+			// never destroyed: userdata in a state closed during static destruction
+			// may still hand its slot back after this pool would have been torn down
+			static pool_state* s = new pool_state();
+			return *s;
+		}
+
+	public:
+		static void* allocate() {
+			pool_state& s = state();
+			std::lock_guard<std::mutex> guard(s.lock);
+			if (s.free_list == nullptr) {
+				s.grow();
+			}
+			slot* target = s.free_list;
+			s.free_list = target->next;
+			--s.stats.slots_free;
+			++s.stats.slots_in_use;
+			if (s.stats.slots_in_use > s.stats.peak_slots_in_use) {
+				s.stats.peak_slots_in_use = s.stats.slots_in_use;
+			}
+			return static_cast<void*>(target->storage);
+		}
+
+		static void deallocate(void* memory) noexcept {
+			if (memory == nullptr) {
+				return;
+			}
+			pool_state& s = state();
+			std::lock_guard<std::mutex> guard(s.lock);
+			slot* target = static_cast<slot*>(memory);
+			target->next = s.free_list;
+			s.free_list = target;
+			--s.stats.slots_in_use;
+			++s.stats.slots_free;
+		}
+
+		static void reserve(std::size_t slot_count) {
+			pool_state& s = state();
+			std::lock_guard<std::mutex> guard(s.lock);
+			while (s.stats.slots_free < slot_count) {
+				s.grow();
+			}
+		}
+
+		static usertype_pool_stats stats() {
+			pool_state& s = state();
+			std::lock_guard<std::mutex> guard(s.lock);
+			return s.stats;
+		}
+	};
+
+	// By default, a value usertype lives inside its own userdata block.
+	// Specialize this to provide `static void* allocate()` and `static void deallocate(void*) noexcept`
+	// (or derive from `sol::usertype_pool<T>`) and sol will place T there instead, keeping only a pointer in the userdata.
+	template <typename T>
+	struct usertype_allocation_policy { };
+
+	namespace meta { namespace meta_detail {
+		template <typename T>
+		using usertype_allocation_allocate_test_t = decltype(usertype_allocation_policy<T>::allocate());
+
+		template <typename T>
+		using usertype_allocation_deallocate_test_t = decltype(usertype_allocation_policy<T>::deallocate(static_cast<void*>(nullptr)));
+	}} // namespace meta::meta_detail
+
+	template <typename T>
+	struct is_usertype_pooled : std::integral_constant<bool,
+	                                 meta::is_detected_v<meta::meta_detail::usertype_allocation_allocate_test_t, T>
+	                                      && meta::is_detected_v<meta::meta_detail::usertype_allocation_deallocate_test_t, T>> { };
+
+	template <typename T>
+	inline constexpr bool is_usertype_pooled_v = is_usertype_pooled<T>::value;
+
+} // namespace sol
+
+#endif // SOL_USERTYPE_ALLOCATION_POLICY_HPP
@@ -393,6 +393,93 @@ namespace sol {
 			return t.second;
 		}
 
+		// remembers the last position an integer index reached in a container
+		// whose iterators cannot jump, so sequential c[i] access from Lua
+		// resumes from there instead of walking from begin() every time;
+		// the position lives in a userdata of its own, held in a weak-keyed
+		// registry table against the container's userdata, so it is collected
+		// with that userdata and a container pushed anew never sees it.
+		// changes made through the container API bump a per-type generation,
+		// which drops the positions kept by every other userdata of the same type
+		template <typename T, typename = void>
+		struct position_cache {
+			static void invalidate() noexcept {
+			}
+		};
+
+		template <typename T>
+		struct position_cache<T,
+		     std::enable_if_t<meta::all<meta::has_iterator<T>,
+		          std::is_base_of<std::forward_iterator_tag, typename meta::iterator_tag<typename T::iterator>::type>>::value>> {
+			using iterator = typename T::iterator;
+
+			iterator first {};
+			iterator it {};
+			std::ptrdiff_t index = 0;
+			std::size_t size = 0;
+			std::size_t generation = 0;
+
+			static std::size_t& current_generation() noexcept {
+#if SOL_IS_ON(SOL_USE_THREAD_LOCAL_I_)
+				static thread_local std::size_t g = 0;
+#else
+				static std::size_t g = 0;
+#endif
+				return g;
+			}
+
+			static void invalidate() noexcept {
+				++current_generation();
+			}
+
+			static const void* registry_key() noexcept {
+				static const char key = 0;
+				return &key;
+			}
+
+			// the position kept for the container userdata at self_index, made if asked for;
+			// leaves the stack as it found it
+			static position_cache* find(lua_State* L, int self_index, bool create) {
+				if (lua_type(L, self_index) != LUA_TUSERDATA) {
+					return nullptr;
+				}
+#if SOL_IS_ON(SOL_SAFE_STACK_CHECK_I_)
+				luaL_checkstack(L, 4, detail::not_enough_stack_space_generic);
+#endif // make sure stack doesn't overflow
+				int top = lua_gettop(L);
+				self_index = lua_absindex(L, self_index);
+				lua_rawgetp(L, LUA_REGISTRYINDEX, registry_key());
+				if (lua_type(L, -1) != LUA_TTABLE) {
+					lua_pop(L, 1);
+					if (!create) {
+						return nullptr;
+					}
+					lua_createtable(L, 0, 0);
+					lua_createtable(L, 0, 1);
+					lua_pushliteral(L, "k");
+					lua_setfield(L, -2, "__mode");
+					lua_setmetatable(L, -2);
+					lua_pushvalue(L, -1);
+					lua_rawsetp(L, LUA_REGISTRYINDEX, registry_key());
+				}
+				lua_pushvalue(L, self_index);
+				lua_rawget(L, -2);
+				position_cache* cached = nullptr;
+				if (lua_type(L, -1) == LUA_TUSERDATA) {
+					cached = &stack::unqualified_get<user<position_cache>>(L, -1);
+				}
+				else if (create) {
+					lua_pop(L, 1);
+					lua_pushvalue(L, self_index);
+					stack::push<user<position_cache>>(L, position_cache());
+					cached = &stack::unqualified_get<user<position_cache>>(L, -1);
+					lua_rawset(L, -3);
+				}
+				lua_settop(L, top);
+				return cached;
+			}
+		};
+
 		template <typename X, typename = void>
 		struct usertype_container_default {
 		private:
@@ -510,6 +597,13 @@ namespace sol {
 			typedef meta::neg<meta::any<std::is_const<V>, std::is_const<std::remove_reference_t<iterator_return>>, meta::neg<is_copyable>>> is_writable;
 			typedef meta::unqualified_t<decltype(get_key(is_associative(), std::declval<std::add_lvalue_reference_t<value_type>>()))> key_type;
 			typedef meta::all<std::is_integral<K>, meta::neg<meta::any<is_associative, is_lookup>>> is_linear_integral;
+			typedef meta::boolean<SOL_IS_ON(SOL_CONTAINER_POSITION_CACHE_I_) && std::is_base_of<std::forward_iterator_tag, iterator_category>::value>
+			     uses_position_cache;
+			typedef std::is_base_of<std::bidirectional_iterator_tag, iterator_category> is_bidirectional;
+			typedef meta::any<is_associative, meta::all<is_lookup, meta::neg<is_matched_lookup>>> is_pairs_associative;
+			// random-access sequences iterate with the container as the state and the position as the control variable,
+			// so pairs/ipairs allocate nothing
+			typedef meta::all<std::is_base_of<std::random_access_iterator_tag, iterator_category>, meta::neg<is_pairs_associative>> is_indexed_iteration;
 
 			struct iter {
 				T& source;
@@ -518,9 +612,6 @@ namespace sol {
 
 				iter(T& source_, iterator it_) : source(source_), it(std::move(it_)), index(0) {
 				}
-
-				~iter() {
-				}
 			};
 
 			static auto& get_src(lua_State* L) {
@@ -541,23 +632,78 @@ namespace sol {
 #endif // Safe getting with error
 			}
 
+			static void invalidate_position() noexcept {
+				if constexpr (uses_position_cache::value) {
+					position_cache<T>::invalidate();
+				}
+			}
+
+			// pos must be non-negative; returns end() if pos is out of range
+			static iterator walk_to(lua_State* L, T& self, std::ptrdiff_t pos) {
+				auto e = deferred_uc::end(L, self);
+				if constexpr (uses_position_cache::value) {
+					// self is always the container userdata at index 1
+					using cache = position_cache<T>;
+					cache* cached = cache::find(L, 1, false);
+					iterator first = deferred_uc::begin(L, self);
+					std::size_t size = 0;
+					if constexpr (meta::has_size<T>::value) {
+						size = static_cast<std::size_t>(self.size());
+					}
+					iterator it = first;
+					std::ptrdiff_t index = 0;
+					if (cached != nullptr && cached->generation == cache::current_generation() && cached->first == first && cached->size == size) {
+						if (cached->index <= pos) {
+							it = cached->it;
+							index = cached->index;
+						}
+						else if constexpr (is_bidirectional::value) {
+							if (cached->index - pos < pos) {
+								it = cached->it;
+								index = cached->index;
+							}
+						}
+					}
+					if constexpr (is_bidirectional::value) {
+						for (; index > pos; --index) {
+							--it;
+						}
+					}
+					for (; index < pos && it != e; ++index) {
+						++it;
+					}
+					if (it != e) {
+						if (cached == nullptr) {
+							cached = cache::find(L, 1, true);
+						}
+						if (cached != nullptr) {
+							cached->first = first;
+							cached->it = it;
+							cached->index = index;
+							cached->size = size;
+							cached->generation = cache::current_generation();
+						}
+					}
+					return it;
+				}
+				else {
+					auto it = deferred_uc::begin(L, self);
+					for (; pos > 0 && it != e; --pos) {
+						++it;
+					}
+					return it;
+				}
+			}
+
 			static detail::error_result at_category(std::input_iterator_tag, lua_State* L, T& self, std::ptrdiff_t pos) {
 				pos += deferred_uc::index_adjustment(L, self);
 				if (pos < 0) {
 					return stack::push(L, lua_nil);
 				}
-				auto it = deferred_uc::begin(L, self);
-				auto e = deferred_uc::end(L, self);
-				if (it == e) {
+				auto it = walk_to(L, self, pos);
+				if (it == deferred_uc::end(L, self)) {
 					return stack::push(L, lua_nil);
 				}
-				while (pos > 0) {
-					--pos;
-					++it;
-					if (it == e) {
-						return stack::push(L, lua_nil);
-					}
-				}
 				return get_associative(is_associative(), L, it);
 			}
 
@@ -591,18 +737,10 @@ namespace sol {
 				if (key < 0) {
 					return stack::push(L, lua_nil);
 				}
-				auto it = deferred_uc::begin(L, self);
-				auto e = deferred_uc::end(L, self);
-				if (it == e) {
+				auto it = walk_to(L, self, static_cast<std::ptrdiff_t>(key));
+				if (it == deferred_uc::end(L, self)) {
 					return stack::push(L, lua_nil);
 				}
-				while (key > 0) {
-					--key;
-					++it;
-					if (it == e) {
-						return stack::push(L, lua_nil);
-					}
-				}
 				return get_associative(is_associative(), L, it);
 			}
 
@@ -665,6 +803,12 @@ namespace sol {
 				decltype(auto) key = okey.as<K>();
 				key = static_cast<K>(static_cast<std::ptrdiff_t>(key) + deferred_uc::index_adjustment(L, self));
 				auto e = deferred_uc::end(L, self);
+				if (key >= 0) {
+					auto it = walk_to(L, self, static_cast<std::ptrdiff_t>(key));
+					if (it != e) {
+						return set_writable(is_writable(), L, self, it, std::move(value));
+					}
+				}
 				auto it = deferred_uc::begin(L, self);
 				auto backit = it;
 				for (; key > 0 && it != e; --key, ++it) {
@@ -672,6 +816,7 @@ namespace sol {
 				}
 				if (it == e) {
 					if (key == 0) {
+						invalidate_position();
 						return add_copyable(is_copyable(), L, self, std::move(value), meta::has_insert_after<T>::value ? backit : it);
 					}
 					return detail::error_result("out of bounds (too big) for set on '%s'", detail::demangle<T>().c_str());
@@ -1191,17 +1336,44 @@ namespace sol {
 				return p;
 			}
 
+			static int next_indexed(lua_State* L) {
+				auto& source = get_src(L);
+				std::ptrdiff_t pos = stack::unqualified_get<std::ptrdiff_t>(L, 2);
+				if (pos < 0 || pos >= static_cast<std::ptrdiff_t>(size_start(L, source))) {
+					return stack::push(L, lua_nil);
+				}
+				auto it = std::next(deferred_uc::begin(L, source), pos);
+				int p = stack::push_reference(L, pos + 1);
+				p += stack::stack_detail::push_reference<push_type>(L, detail::deref_move_only(*it));
+				return p;
+			}
+
 			template <bool ip>
 			static int next_iter(lua_State* L) {
-				typedef meta::any<is_associative, meta::all<is_lookup, meta::neg<is_matched_lookup>>> is_assoc;
-				return next_associative<ip>(is_assoc(), L);
+				if constexpr (is_indexed_iteration::value) {
+					return next_indexed(L);
+				}
+				else {
+					return next_associative<ip>(is_pairs_associative(), L);
+				}
+			}
+
+			template <bool ip>
+			static int push_iter(lua_State* L, T& src) {
+				if constexpr (std::is_trivially_destructible_v<iter>) {
+					// nothing to finalize: skip the metatable and keep the iterator off the finalizer list
+					return stack::push<user<iter>>(L, no_metatable, src, deferred_uc::begin(L, src));
+				}
+				else {
+					return stack::push<user<iter>>(L, src, deferred_uc::begin(L, src));
+				}
 			}
 
 			template <bool ip>
 			static int pairs_associative(std::true_type, lua_State* L) {
 				auto& src = get_src(L);
 				stack::push(L, next_iter<ip>);
-				stack::push<user<iter>>(L, src, deferred_uc::begin(L, src));
+				push_iter<ip>(L, src);
 				stack::push(L, lua_nil);
 				return 3;
 			}
@@ -1210,7 +1382,13 @@ namespace sol {
 			static int pairs_associative(std::false_type, lua_State* L) {
 				auto& src = get_src(L);
 				stack::push(L, next_iter<ip>);
-				stack::push<user<iter>>(L, src, deferred_uc::begin(L, src));
+				if constexpr (is_indexed_iteration::value) {
+					(void)src;
+					lua_pushvalue(L, 1);
+				}
+				else {
+					push_iter<ip>(L, src);
+				}
 				stack::push(L, 0);
 				return 3;
 			}
@@ -1260,6 +1438,10 @@ namespace sol {
 					}
 				}
 				auto& self = get_src(L);
+				if constexpr (!is_linear_integral::value) {
+					// keyed sets may insert
+					invalidate_position();
+				}
 				detail::error_result er = set_start(L, self, stack_object(L, raw_index(2)), std::move(value));
 				return handle_errors(L, er);
 			}
@@ -1270,12 +1452,14 @@ namespace sol {
 
 			static int add(lua_State* L) {
 				auto& self = get_src(L);
+				invalidate_position();
 				detail::error_result er = add_copyable(is_copyable(), L, self, stack_object(L, raw_index(2)));
 				return handle_errors(L, er);
 			}
 
 			static int insert(lua_State* L) {
 				auto& self = get_src(L);
+				invalidate_position();
 				detail::error_result er = insert_copyable(is_copyable(), L, self, stack_object(L, raw_index(2)), stack_object(L, raw_index(3)));
 				return handle_errors(L, er);
 			}
@@ -1320,12 +1504,14 @@ namespace sol {
 
 			static int clear(lua_State* L) {
 				auto& self = get_src(L);
+				invalidate_position();
 				clear_start(L, self);
 				return 0;
 			}
 
 			static int erase(lua_State* L) {
 				auto& self = get_src(L);
+				invalidate_position();
 				detail::error_result er;
 				{
 					decltype(auto) key = stack::unqualified_get<K>(L, 2);
@@ -1344,13 +1530,11 @@ namespace sol {
 			}
 
 			static int pairs(lua_State* L) {
-				typedef meta::any<is_associative, meta::all<is_lookup, meta::neg<is_matched_lookup>>> is_assoc;
-				return pairs_associative<false>(is_assoc(), L);
+				return pairs_associative<false>(is_pairs_associative(), L);
 			}
 
 			static int ipairs(lua_State* L) {
-				typedef meta::any<is_associative, meta::all<is_lookup, meta::neg<is_matched_lookup>>> is_assoc;
-				return pairs_associative<true>(is_assoc(), L);
+				return pairs_associative<true>(is_pairs_associative(), L);
 			}
 
 			static int next(lua_State* L) {
@@ -1369,14 +1553,6 @@ namespace sol {
 			typedef value_type* iterator;
 
 		private:
-			struct iter {
-				T& source;
-				iterator it;
-
-				iter(T& source, iterator it) : source(source), it(std::move(it)) {
-				}
-			};
-
 			static auto& get_src(lua_State* L) {
 				auto p = stack::unqualified_check_get<T*>(L, 1);
 #if SOL_IS_ON(SOL_SAFE_USERTYPE_I_)
@@ -1413,17 +1589,16 @@ namespace sol {
 			}
 
 			static int next_iter(lua_State* L) {
-				iter& i = stack::unqualified_get<user<iter>>(L, 1);
-				auto& source = i.source;
-				auto& it = i.it;
+				T& source = get_src(L);
 				std::size_t k = stack::unqualified_get<std::size_t>(L, 2);
-				if (it == deferred_uc::end(L, source)) {
+				iterator it = deferred_uc::begin(L, source);
+				if (k >= static_cast<std::size_t>(deferred_uc::end(L, source) - it)) {
 					return 0;
 				}
+				it += k;
 				int p;
 				p = stack::push(L, k + 1);
 				p += stack::push_reference(L, detail::deref_move_only(*it));
-				std::advance(it, 1);
 				return p;
 			}
 
@@ -1497,9 +1672,10 @@ namespace sol {
 			}
 
 			static int pairs(lua_State* L) {
-				auto& src = get_src(L);
+				// the array itself is the iteration state and the position the control variable: nothing to allocate
+				get_src(L);
 				stack::push(L, next_iter);
-				stack::push<user<iter>>(L, src, deferred_uc::begin(L, src));
+				lua_pushvalue(L, 1);
 				stack::push(L, 0);
 				return 3;
 			}
@@ -328,8 +328,8 @@ namespace sol {
 				void operator()() {
 					using meta_usertype_container
 					     = container_detail::u_c_launch<meta::conditional_t<is_shim, as_container_t<std::remove_pointer_t<T>>, std::remove_pointer_t<T>>>;
-					static const char* metakey
-					     = is_shim ? &usertype_traits<as_container_t<std::remove_pointer_t<T>>>::metatable()[0] : &usertype_traits<T>::metatable()[0];
+					using meta_type = meta::conditional_t<is_shim, as_container_t<std::remove_pointer_t<T>>, T>;
+					static const char* metakey = &usertype_traits<meta_type>::metatable()[0];
 					static const std::array<luaL_Reg, 20> reg = { {
 						// clang-format off
 						{ "__pairs", &meta_usertype_container::pairs_call },
@@ -355,7 +355,7 @@ namespace sol {
 						// clang-format on 
 					} };
 
-					if (luaL_newmetatable(L, metakey) == 1) {
+					if (new_usertype_metatable(L, usertype_cache_key<meta_type>(), metakey) == 1) {
 						luaL_setfuncs(L, reg.data(), 0);
 					}
 					lua_setmetatable(L, -2);
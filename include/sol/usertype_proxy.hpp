@@ -70,7 +70,7 @@ namespace sol {
 		key_type key;
 
 		template <typename T>
-		usertype_proxy(Table table, T&& k) : tbl(table), key(std::forward<T>(k)) {
+		usertype_proxy(Table table, T&& k) : tbl(std::forward<Table>(table)), key(std::forward<T>(k)) {
 		}
 
 		template <typename T>
@@ -134,7 +134,7 @@ namespace sol {
 		template <typename K>
 		decltype(auto) operator[](K&& k) && {
 			auto keys = meta::tuplefy(std::move(key), std::forward<K>(k));
-			return usertype_proxy<Table, decltype(keys)>(tbl, std::move(keys));
+			return usertype_proxy<Table, decltype(keys)>(std::forward<Table>(tbl), std::move(keys));
 		}
 
 		template <typename... Ret, typename... Args>
@@ -28,6 +28,7 @@
 #include <sol/make_reference.hpp>
 
 #include <bitset>
+#include <cstdint>
 #include <unordered_map>
 
 namespace sol { namespace u_detail {
@@ -57,6 +58,11 @@ namespace sol { namespace u_detail {
 		void* new_binding_data;
 	};
 
+	struct frozen_key_entry {
+		const char* key;
+		index_call_storage* target;
+	};
+
 	struct binding_base {
 		virtual void* data() = 0;
 		virtual ~binding_base() {
@@ -288,6 +294,8 @@ namespace sol { namespace u_detail {
 		std::vector<std::unique_ptr<char[]>> string_keys_storage;
 		std::unordered_map<string_view, index_call_storage> string_keys;
 		std::unordered_map<reference, reference, reference_hash, reference_equals> auxiliary_keys;
+		std::vector<frozen_key_entry> frozen_keys;
+		reference frozen_keys_table;
 		reference value_index_table;
 		reference reference_index_table;
 		reference unique_index_table;
@@ -301,12 +309,15 @@ namespace sol { namespace u_detail {
 		new_index_call_storage static_base_index;
 		bool is_using_index;
 		bool is_using_new_index;
+		bool is_frozen;
 		std::bitset<64> properties;
 
 		usertype_storage_base(lua_State* L)
 		: storage()
 		, string_keys()
 		, auxiliary_keys()
+		, frozen_keys()
+		, frozen_keys_table()
 		, value_index_table()
 		, reference_index_table()
 		, unique_index_table()
@@ -318,6 +329,7 @@ namespace sol { namespace u_detail {
 		, static_base_index()
 		, is_using_index(false)
 		, is_using_new_index(false)
+		, is_frozen(false)
 		, properties() {
 			base_index.binding_data = nullptr;
 			base_index.index = index_target_fail;
@@ -367,6 +379,64 @@ namespace sol { namespace u_detail {
 			string_keys.insert_or_assign(std::move(stored_sv), std::move(ics));
 		}
 
+		static std::size_t frozen_key_hash(const char* key) {
+			std::size_t h = static_cast<std::size_t>(reinterpret_cast<std::uintptr_t>(key) >> 3);
+			return h ^ (h >> 7) ^ (h >> 17);
+		}
+
+		index_call_storage* find_frozen_key(const char* key) const {
+			// the table is always a power of 2 and at most half full,
+			// so the linear probe is guaranteed to hit an empty slot
+			std::size_t mask = frozen_keys.size() - 1;
+			for (std::size_t i = frozen_key_hash(key) & mask;; i = (i + 1) & mask) {
+				const frozen_key_entry& entry = frozen_keys[i];
+				if (entry.key == key) {
+					return entry.target;
+				}
+				if (entry.key == nullptr) {
+					return nullptr;
+				}
+			}
+		}
+
+		void build_frozen_keys(lua_State* L) {
+			frozen_keys.clear();
+			std::size_t capacity = 8;
+			while (capacity < string_keys.size() * 2) {
+				capacity <<= 1;
+			}
+			frozen_keys.resize(capacity, frozen_key_entry { nullptr, nullptr });
+			// anchor every key as a Lua string:
+			// (short) Lua strings are interned, so as long as these stay alive
+			// any string with the same contents Lua hands us later has the same address
+			lua_createtable(L, static_cast<int>(string_keys.size()), 0);
+			lua_Integer anchor_index = 1;
+			std::size_t mask = capacity - 1;
+			for (auto& kvp : string_keys) {
+				lua_pushlstring(L, kvp.first.data(), kvp.first.size());
+				const char* interned_key = lua_tolstring(L, -1, nullptr);
+				lua_rawseti(L, -2, anchor_index++);
+				std::size_t i = frozen_key_hash(interned_key) & mask;
+				while (frozen_keys[i].key != nullptr) {
+					i = (i + 1) & mask;
+				}
+				frozen_keys[i] = frozen_key_entry { interned_key, &kvp.second };
+			}
+			frozen_keys_table = reference(L, -1);
+			lua_pop(L, 1);
+		}
+
+		void freeze(lua_State* L) {
+			is_frozen = true;
+			build_frozen_keys(L);
+		}
+
+		void thaw() {
+			is_frozen = false;
+			frozen_keys.clear();
+			frozen_keys_table = lua_nil;
+		}
+
 		template <typename T, typename... Bases>
 		void update_bases(lua_State* L, bases<Bases...>) {
 			static_assert(sizeof(void*) <= sizeof(detail::inheritance_check_function),
@@ -441,6 +511,7 @@ namespace sol { namespace u_detail {
 			gc_names_table = lua_nil;
 			named_metatable = lua_nil;
 
+			thaw();
 			storage.clear();
 			string_keys.clear();
 			auxiliary_keys.clear();
@@ -474,9 +545,16 @@ namespace sol { namespace u_detail {
 				index_call_storage* target = nullptr;
 				{
 					string_view k = stack::get<string_view>(L, 2);
-					auto it = self.string_keys.find(k);
-					if (it != self.string_keys.cend()) {
-						target = &it->second;
+					if (!self.frozen_keys.empty()) {
+						// pointer compare against the interned keys;
+						// long (non-interned) strings miss and take the hashed path
+						target = self.find_frozen_key(k.data());
+					}
+					if (target == nullptr) {
+						auto it = self.string_keys.find(k);
+						if (it != self.string_keys.cend()) {
+							target = &it->second;
+						}
 					}
 				}
 				if (target != nullptr) {
@@ -661,6 +739,9 @@ namespace sol { namespace u_detail {
 		}
 		else if constexpr ((meta::is_string_like_or_constructible<KeyU>::value || std::is_same_v<KeyU, meta_function>)) {
 			std::string s = u_detail::make_string(std::forward<Key>(key));
+			// entries are about to be moved around: drop the frozen table
+			// until the new key is in place
+			this->frozen_keys.clear();
 			auto storage_it = this->storage.end();
 			auto string_it = this->string_keys.find(s);
 			if (string_it != this->string_keys.cend()) {
@@ -739,6 +820,9 @@ namespace sol { namespace u_detail {
 			}
 			this->for_each_table(L, for_each_fx);
 			this->add_entry(s, std::move(ics));
+			if (this->is_frozen) {
+				this->build_frozen_keys(L);
+			}
 		}
 		else {
 			// the reference-based implementation might compare poorly and hash
@@ -26,34 +26,95 @@
 
 #include <sol/demangle.hpp>
 
+#include <cstdint>
+
 namespace sol {
 
+	namespace detail {
+		constexpr std::uint64_t usertype_type_id(string_view name) {
+			// FNV-1a: stable for the same name across modules,
+			// unlike the address of any per-type static
+			std::uint64_t h = 14695981039346656037ull;
+			for (char c : name) {
+				h ^= static_cast<unsigned char>(c);
+				h *= 1099511628211ull;
+			}
+			return h;
+		}
+
+		template <std::size_t N>
+		constexpr ctti_name_buffer<N> make_usertype_key(string_view name, string_view suffix) {
+			constexpr string_view prefix = "sol.";
+			ctti_name_buffer<N> buffer {};
+			for (char c : prefix)
+				buffer.data[buffer.size++] = c;
+			for (char c : name)
+				buffer.data[buffer.size++] = c;
+			for (char c : suffix)
+				buffer.data[buffer.size++] = c;
+			return buffer;
+		}
+
+		template <typename T>
+		struct usertype_keys {
+			static constexpr string_view name = demangle_view<T>();
+			static constexpr string_view user_suffix = ".user";
+			static constexpr string_view user_gc_suffix = ".user\xE2\x99\xBB";
+			static constexpr string_view gc_suffix = ".\xE2\x99\xBB";
+
+			static constexpr ctti_name_buffer<name.size() + 5> metatable = make_usertype_key<name.size() + 5>(name, string_view());
+			static constexpr ctti_name_buffer<name.size() + user_suffix.size() + 5> user_metatable
+			     = make_usertype_key<name.size() + user_suffix.size() + 5>(name, user_suffix);
+			static constexpr ctti_name_buffer<name.size() + user_gc_suffix.size() + 5> user_gc_metatable
+			     = make_usertype_key<name.size() + user_gc_suffix.size() + 5>(name, user_gc_suffix);
+			static constexpr ctti_name_buffer<name.size() + gc_suffix.size() + 5> gc_table
+			     = make_usertype_key<name.size() + gc_suffix.size() + 5>(name, gc_suffix);
+		};
+	} // namespace detail
+
 	template <typename T>
 	struct usertype_traits {
 		static const std::string& name() {
-			static const std::string& n = detail::short_demangle<T>();
+			static const std::string n(detail::short_demangle_view<T>());
 			return n;
 		}
 		static const std::string& qualified_name() {
-			static const std::string& q_n = detail::demangle<T>();
+			static const std::string q_n(detail::demangle_view<T>());
 			return q_n;
 		}
+		static constexpr std::uint64_t type_id() {
+			return detail::usertype_type_id(detail::demangle_view<T>());
+		}
 		static const std::string& metatable() {
-			static const std::string m = std::string("sol.").append(detail::demangle<T>());
+			static const std::string m(metatable_view());
 			return m;
 		}
 		static const std::string& user_metatable() {
-			static const std::string u_m = std::string("sol.").append(detail::demangle<T>()).append(".user");
+			static const std::string u_m(user_metatable_view());
 			return u_m;
 		}
 		static const std::string& user_gc_metatable() {
-			static const std::string u_g_m = std::string("sol.").append(detail::demangle<T>()).append(".user\xE2\x99\xBB");
+			static const std::string u_g_m(user_gc_metatable_view());
 			return u_g_m;
 		}
 		static const std::string& gc_table() {
-			static const std::string g_t = std::string("sol.").append(detail::demangle<T>()).append(".\xE2\x99\xBB");
+			static const std::string g_t(gc_table_view());
 			return g_t;
 		}
+
+		// the same keys, computed at compile time; the views are null-terminated
+		static constexpr string_view metatable_view() {
+			return detail::usertype_keys<T>::metatable.view();
+		}
+		static constexpr string_view user_metatable_view() {
+			return detail::usertype_keys<T>::user_metatable.view();
+		}
+		static constexpr string_view user_gc_metatable_view() {
+			return detail::usertype_keys<T>::user_gc_metatable.view();
+		}
+		static constexpr string_view gc_table_view() {
+			return detail::usertype_keys<T>::gc_table.view();
+		}
 	};
 
 } // namespace sol
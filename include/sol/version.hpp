@@ -129,6 +129,17 @@
 #define SOL_PLATFORM_APPLE_IPHONE_I_ SOL_OFF
 #define SOL_PLATFORM_BSDLIKE_I_      SOL_OFF
 
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define SOL_PLATFORM_SSE2_I_ SOL_ON
+#else
+	#define SOL_PLATFORM_SSE2_I_ SOL_OFF
+#endif
+#if defined(__AVX2__)
+	#define SOL_PLATFORM_AVX2_I_ SOL_ON
+#else
+	#define SOL_PLATFORM_AVX2_I_ SOL_OFF
+#endif
+
 #if defined(SOL_IN_DEBUG_DETECTED)
 	#if SOL_IN_DEBUG_DETECTED != 0
 		#define SOL_DEBUG_BUILD_I_ SOL_ON
@@ -613,6 +624,42 @@
 	#define SOL_USE_UNSAFE_BASE_LOOKUP_I_ SOL_OFF
 #endif
 
+#if defined(SOL_OVERLOAD_DISPATCH_TABLE)
+	#if (SOL_OVERLOAD_DISPATCH_TABLE != 0)
+		#define SOL_OVERLOAD_DISPATCH_TABLE_I_ SOL_ON
+	#else
+		#define SOL_OVERLOAD_DISPATCH_TABLE_I_ SOL_OFF
+	#endif
+#else
+	#define SOL_OVERLOAD_DISPATCH_TABLE_I_ SOL_OFF
+#endif
+
+#if defined(SOL_OVERLOAD_DISPATCH_ARGUMENTS) && SOL_OVERLOAD_DISPATCH_ARGUMENTS > 0
+	#define SOL_OVERLOAD_DISPATCH_ARGUMENTS_I_ SOL_OVERLOAD_DISPATCH_ARGUMENTS
+#else
+	#define SOL_OVERLOAD_DISPATCH_ARGUMENTS_I_ 4
+#endif
+
+#if defined(SOL_UNICODE_SIMD)
+	#if (SOL_UNICODE_SIMD != 0)
+		#define SOL_UNICODE_SIMD_I_ SOL_ON
+	#else
+		#define SOL_UNICODE_SIMD_I_ SOL_OFF
+	#endif
+#else
+	#define SOL_UNICODE_SIMD_I_ SOL_DEFAULT_ON
+#endif
+
+#if defined(SOL_CONTAINER_POSITION_CACHE)
+	#if (SOL_CONTAINER_POSITION_CACHE != 0)
+		#define SOL_CONTAINER_POSITION_CACHE_I_ SOL_ON
+	#else
+		#define SOL_CONTAINER_POSITION_CACHE_I_ SOL_OFF
+	#endif
+#else
+	#define SOL_CONTAINER_POSITION_CACHE_I_ SOL_DEFAULT_OFF
+#endif
+
 #if defined(SOL_INSIDE_UNREAL)
 	#if (SOL_INSIDE_UNREAL != 0)
 		#define SOL_INSIDE_UNREAL_ENGINE_I_ SOL_ON
@@ -0,0 +1,66 @@
+#include <sol/sol.hpp>
+
+#include <assert.hpp>
+
+#include <iostream>
+#include <list>
+#include <forward_list>
+#include <map>
+#include <numeric>
+
+int main() {
+	sol::state lua;
+	lua.open_libraries(sol::lib::base);
+
+	std::list<int> a(50);
+	std::iota(a.begin(), a.end(), 1);
+	std::list<int> b(a.begin(), a.end());
+	std::forward_list<int> fl(a.begin(), a.end());
+	std::map<int, int> m;
+	for (int i = 1; i <= 50; ++i) {
+		m.emplace(i, i);
+	}
+	lua["a"] = &a;
+	lua["b"] = &b;
+	lua["fl"] = &fl;
+	lua["m"] = &m;
+	std::list<int> c(a.begin(), a.end());
+	lua["c"] = &c;
+	lua["c2"] = &c;
+
+	const char code[] = R"(
+for _, c in ipairs({ a, fl }) do
+	for i = 1, #c do assert(c[i] == i) end
+	for i = #c, 1, -1 do assert(c[i] == i) end
+	for i = 1, #c, 7 do assert(c[i] == i) assert(c[51 - i] == 51 - i) end
+	assert(c[#c + 1] == nil)
+end
+for i = 1, 50 do assert(a[i] == b[i]) assert(fl[i] == m:at(i)) end
+a:erase(10)
+assert(a[10] == 11)
+b[10] = 100
+assert(b[10] == 100)
+a:insert(1, 0)
+assert(a[1] == 0 and a[2] == 1)
+m[0] = 0
+assert(m:at(1) == 0)
+a:clear()
+assert(a[1] == nil)
+assert(c[20] == 20)
+c2:erase(20)
+c2:insert(20, 200)
+assert(#c == 50)
+assert(c[20] == 200 and c[21] == 21 and c[19] == 19)
+	)";
+
+	sol::optional<sol::error> err = lua.safe_script(code, sol::script_pass_on_error);
+	if (err.has_value()) {
+		std::cerr << err.value().what() << std::endl;
+		return 1;
+	}
+	c_assert(!err.has_value());
+	c_assert(a.empty());
+	c_assert(m.size() == 51);
+
+	return 0;
+}
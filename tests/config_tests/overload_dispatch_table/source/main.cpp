@@ -0,0 +1,85 @@
+#include <sol/sol.hpp>
+
+#include <assert.hpp>
+
+#include <iostream>
+#include <string>
+
+struct vec2 {
+	double x = 0;
+	double y = 0;
+
+	std::string scale(double) const {
+		return "scale number";
+	}
+
+	std::string scale(const vec2&) const {
+		return "scale vec2";
+	}
+};
+
+int main() {
+	static_assert(sol::call_detail::overload_detail::dispatch_enabled, "the dispatch table must be on for this test");
+
+	sol::state lua;
+	lua.open_libraries(sol::lib::base);
+
+	lua.new_usertype<vec2>("vec2",
+	     sol::constructors<vec2()>(),
+	     "x",
+	     &vec2::x,
+	     "y",
+	     &vec2::y,
+	     "scale",
+	     sol::overload(sol::resolve<std::string(double) const>(&vec2::scale), sol::resolve<std::string(const vec2&) const>(&vec2::scale)));
+	lua.set_function("describe",
+	     sol::overload([](const vec2&, const vec2&) { return std::string("vec2 vec2"); },
+	          [](const vec2&, double) { return std::string("vec2 number"); },
+	          [](double, const vec2&) { return std::string("number vec2"); },
+	          [](const std::string&, sol::table) { return std::string("string table"); },
+	          [](double, double) { return std::string("number number"); },
+	          [](sol::object, sol::object) { return std::string("object object"); }));
+	lua.set_function("convert",
+	     sol::overload([](sol::function f) { return "function " + f.call<std::string>(); },
+	          [](const std::string& s) { return "string " + s; },
+	          [](bool) { return std::string("boolean"); }));
+	lua.set_function("arity",
+	     sol::overload([]() { return 0; }, [](int) { return 1; }, [](int, int) { return 2; }, [](int, int, int, int, int) { return 5; }));
+
+	const char code[] = R"(
+v = vec2.new()
+assert(describe(v, v) == "vec2 vec2")
+assert(describe(v, 2) == "vec2 number")
+assert(describe(2, v) == "number vec2")
+assert(describe("2", {}) == "string table")
+assert(describe(1, 2) == "number number")
+assert(describe(true, false) == "object object")
+assert(describe({}, v) == "object object")
+
+assert(v:scale(2) == "scale number")
+assert(v:scale(v) == "scale vec2")
+
+local callable = setmetatable({}, { __call = function() return "table" end })
+assert(convert(function() return "lua" end) == "function lua")
+assert(convert(callable) == "function table")
+assert(convert("x") == "string x")
+assert(convert(5) == "string 5")
+assert(convert(true) == "boolean")
+
+assert(arity() == 0)
+assert(arity(1) == 1)
+assert(arity(1, 2) == 2)
+assert(arity(1, 2, 3, 4, 5) == 5)
+assert(not pcall(arity, 1, 2, 3))
+assert(not pcall(describe, v))
+	)";
+
+	sol::optional<sol::error> err = lua.safe_script(code, sol::script_pass_on_error);
+	if (err.has_value()) {
+		std::cerr << err.value().what() << std::endl;
+		return 1;
+	}
+	c_assert(!err.has_value());
+
+	return 0;
+}
@@ -410,6 +410,107 @@ c_arr[3] = 7
 	REQUIRE(result2.valid());
 }
 
+TEST_CASE("containers/positional access", "indexing non-random-access containers resumes from the last position and stays correct across mutation") {
+	sol::state lua;
+	sol::stack_guard luasg(lua);
+	lua.open_libraries(sol::lib::base);
+
+	std::list<int> l(50);
+	std::iota(l.begin(), l.end(), 1);
+	std::forward_list<int> fl(l.begin(), l.end());
+	std::map<int, int> m;
+	for (int i = 1; i <= 50; ++i) {
+		m.emplace(i, i);
+	}
+	lua["l"] = &l;
+	lua["fl"] = &fl;
+	lua["m"] = &m;
+
+	auto result = lua.safe_script(R"(
+for _, c in ipairs({ l, fl }) do
+	for i = 1, #c do assert(c[i] == i) end
+	for i = #c, 1, -1 do assert(c[i] == i) end
+	for i = 1, #c, 7 do assert(c[i] == i) assert(c[51 - i] == 51 - i) end
+	assert(c[#c + 1] == nil)
+	assert(c[1] == 1)
+end
+for i = 1, 50 do assert(m:at(i) == i) end
+for i = 1, 50 do assert(l[i] == fl[i]) end
+
+for i = 1, 25 do l[i] = i * 2 end
+for i = 1, 25 do assert(l[i] == i * 2) end
+
+assert(l[10] == 20)
+l:erase(10)
+assert(l[10] == 22)
+l:add(100)
+assert(l[50] == 100)
+assert(l[51] == nil)
+l:insert(1, 0)
+assert(l[1] == 0)
+assert(l[2] == 2)
+m[0] = 0
+assert(m:at(1) == 0)
+assert(m:at(2) == 1)
+l:clear()
+assert(l[1] == nil)
+)",
+	     sol::script_pass_on_error);
+	REQUIRE(result.valid());
+	REQUIRE(l.empty());
+	REQUIRE(m.size() == 51);
+
+	l.assign({ 5, 6, 7 });
+	auto cpp_mutated = lua.safe_script("assert(l[2] == 6) assert(l[3] == 7)", sol::script_pass_on_error);
+	REQUIRE(cpp_mutated.valid());
+
+	lua.set_function("make_list", []() {
+		std::list<int> r(10);
+		std::iota(r.begin(), r.end(), 1);
+		return r;
+	});
+	auto collected = lua.safe_script(R"(
+for j = 1, 20 do
+	local c = make_list()
+	for i = 1, #c do assert(c[i] == i) end
+	c = nil
+	collectgarbage()
+end
+)",
+	     sol::script_pass_on_error);
+	REQUIRE(collected.valid());
+}
+
+TEST_CASE("containers/positional access after C++ mutation", "changing a container from C++ without changing its size or begin() is seen by the next index from Lua") {
+	sol::state lua;
+	sol::stack_guard luasg(lua);
+	lua.open_libraries(sol::lib::base);
+
+	std::list<int> l { 1, 2, 3, 4, 5 };
+	std::forward_list<int> fl { 1, 2, 3, 4, 5 };
+	std::map<int, int> m { { 1, 1 }, { 2, 2 }, { 3, 3 }, { 4, 4 }, { 5, 5 } };
+	lua["l"] = &l;
+	lua["fl"] = &fl;
+	lua["m"] = &m;
+
+	auto walked = lua.safe_script("assert(l[4] == 4) assert(fl[4] == 4) assert(m:at(4) == 4)", sol::script_pass_on_error);
+	REQUIRE(walked.valid());
+
+	l.erase(std::next(l.begin(), 3));
+	l.push_back(6);
+	fl.erase_after(std::next(fl.begin(), 2));
+	m.erase(4);
+	m.emplace(6, 6);
+
+	auto after = lua.safe_script(R"(
+assert(l[4] == 5 and l[5] == 6)
+assert(fl[4] == 5 and fl[5] == nil)
+assert(m:at(4) == 5 and m:at(5) == 6)
+)",
+	     sol::script_pass_on_error);
+	REQUIRE(after.valid());
+}
+
 TEST_CASE("containers/indices test", "test indices on fixed array types") {
 #if 0
 	SECTION("zero index test") {
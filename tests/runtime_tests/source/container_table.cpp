@@ -106,6 +106,48 @@ TEST_CASE("containers/forward_list table roundtrip", "make sure forward_lists ca
 	REQUIRE(areequal);
 }
 
+TEST_CASE("containers/sequence table get", "plain sequences and metatable-backed tables convert to the same containers") {
+	sol::state lua;
+	sol::stack_guard luasg(lua);
+	lua.open_libraries(sol::lib::base);
+
+	auto result1 = lua.safe_script(R"(
+numbers = {}
+for i = 1, 100000 do numbers[i] = i * 0.5 end
+integers = { 1, 2.0, 3, "4", 5.6 }
+zeroed = { [0] = 10, 11, 12 }
+words = { "a", "b", "c" }
+proxied = setmetatable({}, { __index = function(t, k) if k >= 1 and k <= 3 then return k * 7 end end })
+)",
+	     sol::script_pass_on_error);
+	REQUIRE(result1.valid());
+
+	sol::as_table_t<std::vector<double>> numbers = lua["numbers"];
+	REQUIRE(numbers.value().size() == 100000);
+	REQUIRE(numbers.value().front() == 0.5);
+	REQUIRE(numbers.value().back() == 50000.0);
+
+	sol::as_table_t<std::deque<int>> integers = lua["integers"];
+	REQUIRE(integers.value() == std::deque<int> { 1, 2, 3, 4, 6 });
+
+	sol::as_table_t<std::vector<int>> zeroed = lua["zeroed"];
+	REQUIRE(zeroed.value() == std::vector<int> { 10, 11, 12 });
+
+	sol::as_table_t<std::list<std::string>> words = lua["words"];
+	REQUIRE(words.value() == std::list<std::string> { "a", "b", "c" });
+
+	sol::as_table_t<std::vector<int>> proxied = lua["proxied"];
+	REQUIRE(proxied.value() == std::vector<int> { 7, 14, 21 });
+
+	sol::as_table_t<std::vector<char>> letters = lua["words"];
+	REQUIRE(letters.value() == std::vector<char> { 'a', 'b', 'c' });
+	lua["letters"] = sol::as_table(std::vector<char> { 'x', 'y' });
+	auto result2 = lua.safe_script("assert(letters[1] == 'x' and letters[2] == 'y')", sol::script_pass_on_error);
+	REQUIRE(result2.valid());
+	sol::as_table_t<std::vector<char>> letters_back = lua["letters"];
+	REQUIRE(letters_back.value() == std::vector<char> { 'x', 'y' });
+}
+
 TEST_CASE("containers/map table roundtrip", "make sure maps can be round-tripped") {
 	sol::state lua;
 	std::map<std::string, int> v { { "a", 1 }, { "b", 2 }, { "c", 3 } };
@@ -501,6 +501,47 @@ TEST_CASE("containers/pairs", "test how well pairs work with the underlying syst
 	REQUIRE(dv2 == sol::lua_nil);
 }
 
+TEST_CASE("containers/pairs without iterator objects", "random-access containers iterate with the container as the state and no extra userdata") {
+	sol::state lua;
+	sol::stack_guard luasg(lua);
+	lua.open_libraries(sol::lib::base);
+
+	std::vector<int> v { 10, 20, 30 };
+	int arr[3] = { 10, 20, 30 };
+	std::list<int> l { 10, 20, 30 };
+	lua["v"] = &v;
+	lua["arr"] = &arr;
+	lua["l"] = &l;
+
+	auto result = lua.safe_script(R"(
+for _, c in ipairs({ v, arr, l }) do
+	local sum, count = 0, 0
+	local f, s, k = c:pairs()
+	for i, x in f, s, k do
+		assert(x == i * 10)
+		sum = sum + x
+		count = count + 1
+	end
+	assert(sum == 60 and count == 3)
+end
+local _, vs = v:pairs()
+assert(type(vs) == "userdata" and rawequal(vs, v))
+local _, as = arr:pairs()
+assert(rawequal(as, arr))
+local _, ls = l:pairs()
+assert(not rawequal(ls, l))
+local seen = 0
+for i, x in v:pairs() do
+	seen = seen + 1
+	if i == 1 then v:add(40) end
+end
+assert(seen == 4)
+)",
+	     sol::script_pass_on_error);
+	REQUIRE(result.valid());
+	REQUIRE(v.size() == 4);
+}
+
 TEST_CASE("containers/pointer types", "check that containers with unique usertypes and pointers or something") {
 	struct base_t {
 		virtual int get() const = 0;
@@ -547,3 +588,54 @@ TEST_CASE("containers/pointer types", "check that containers with unique usertyp
 	int val2 = b2->get();
 	REQUIRE(val2 == 500);
 }
+
+TEST_CASE("containers/array_view", "array_view reads and writes the viewed buffer in place, with bounds checks and bulk copies") {
+	sol::state lua;
+	lua.open_libraries(sol::lib::base);
+
+	std::vector<double> buffer { 1.0, 2.0, 3.0, 4.0 };
+	const std::array<int, 3> constants { 10, 20, 30 };
+	lua["v"] = sol::array_view<double>(buffer);
+	lua["c"] = sol::array_view(constants);
+
+	auto result1 = lua.safe_script(R"(
+assert(#v == 4)
+assert(v[1] == 1.0 and v[4] == 4.0)
+assert(v[0] == nil and v[5] == nil)
+v[2] = 20.5
+local sum = 0
+for _, x in ipairs(v) do sum = sum + x end
+assert(sum == 28.5)
+assert(c[3] == 30)
+)",
+	     sol::script_pass_on_error);
+	REQUIRE(result1.valid());
+	REQUIRE(buffer[1] == 20.5);
+
+	buffer[0] = 100.0;
+	auto result2 = lua.safe_script("assert(v[1] == 100.0)", sol::script_pass_on_error);
+	REQUIRE(result2.valid());
+
+	auto result3 = lua.safe_script(R"(
+v:fill(0.5)
+local copied = v:copy_from_table({ 7, 8, 9 }, 2)
+assert(copied == 3)
+local t = v:copy_to_table()
+assert(#t == 4 and t[1] == 0.5 and t[2] == 7 and t[4] == 9)
+local dst = { "x", "y", "z", "w", "extra" }
+assert(rawequal(c:copy_to_table(dst), dst))
+assert(dst[1] == 10 and dst[3] == 30 and dst[4] == "w")
+)",
+	     sol::script_pass_on_error);
+	REQUIRE(result3.valid());
+	REQUIRE(buffer == std::vector<double> { 0.5, 7.0, 8.0, 9.0 });
+
+	auto out_of_bounds = lua.safe_script("v[5] = 1", sol::script_pass_on_error);
+	REQUIRE_FALSE(out_of_bounds.valid());
+	auto grow = lua.safe_script("v:add(1)", sol::script_pass_on_error);
+	REQUIRE_FALSE(grow.valid());
+	auto read_only = lua.safe_script("c[1] = 1", sol::script_pass_on_error);
+	REQUIRE_FALSE(read_only.valid());
+	REQUIRE(constants[0] == 10);
+	REQUIRE(buffer.size() == 4);
+}
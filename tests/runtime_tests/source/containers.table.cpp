@@ -266,3 +266,99 @@ TEST_CASE("containers/as_table with pointers", "test to make sure pointers are r
 	REQUIRE(f2 == reinterpret_cast<Entity*>(0x02));
 	REQUIRE(f3 == reinterpret_cast<Entity*>(0x03));
 }
+
+TEST_CASE("containers/as_table size hints", "associative containers and explicit hints presize the table they are pushed into") {
+	sol::state lua;
+	lua.open_libraries(sol::lib::base);
+
+	std::unordered_map<std::string, int> names;
+	for (int i = 0; i < 500; ++i) {
+		names.emplace("key" + std::to_string(i), i);
+	}
+	std::map<int, int> squares { { 1, 1 }, { 2, 4 }, { 3, 9 } };
+	std::vector<std::vector<int>> grid { { 1, 2 }, { 3, 4 } };
+
+	lua["names"] = sol::as_table(names);
+	lua["names_ref"] = sol::as_table_ref(names, sol::new_table(0, 1024));
+	lua["squares"] = sol::as_table(squares);
+	lua["explicit"] = sol::as_table(std::vector<int> { 1, 2, 3 }, sol::new_table(3, 2));
+	lua["nested_grid"] = sol::as_nested(grid, sol::new_table(2));
+	lua["no_hint"] = sol::as_table(std::vector<int> { 5, 6 }, sol::new_table(-1, -1));
+
+	auto result = lua.safe_script(R"(
+local count = 0
+for k, v in pairs(names) do
+	assert(k == "key" .. v)
+	count = count + 1
+end
+assert(count == 500)
+count = 0
+for k, v in pairs(names_ref) do
+	assert(k == "key" .. v)
+	count = count + 1
+end
+assert(count == 500)
+assert(#squares == 3 and squares[3] == 9)
+assert(#explicit == 3 and explicit[2] == 2)
+explicit.extra = true
+assert(nested_grid[2][1] == 3)
+assert(#no_hint == 2 and no_hint[1] == 5)
+)",
+	     sol::script_pass_on_error);
+	REQUIRE(result.valid());
+
+	sol::as_table_t<std::unordered_map<std::string, int>> back = lua["names"];
+	REQUIRE(back.value() == names);
+}
+
+TEST_CASE("containers/as_table numeric sequences", "sequences of numbers are pushed and read back without per-element dispatch") {
+	sol::state lua;
+	lua.open_libraries(sol::lib::base);
+
+	std::vector<double> samples { 0.5, 1.5, -2.25, 1e300 };
+	std::array<int, 4> counts { { 1, -2, 3, -4 } };
+	const std::int64_t ids[3] = { 1, std::numeric_limits<std::int64_t>::max(), std::numeric_limits<std::int64_t>::min() };
+	std::list<float> readings { 0.25f, 0.75f };
+
+	lua["samples"] = sol::as_table(samples);
+	lua["counts"] = sol::as_table(counts);
+	lua["ids"] = sol::as_table_ref(ids);
+	lua["readings"] = sol::as_table(readings);
+	lua["nested_counts"] = sol::as_nested(std::vector<std::vector<int>> { { 1, 2 }, { 3 } });
+
+	auto result = lua.safe_script(R"(
+assert(#samples == 4 and samples[3] == -2.25 and samples[4] == 1e300)
+assert(#counts == 4 and counts[2] == -2 and math.type(counts[2]) == "integer")
+assert(#ids == 3 and ids[2] == math.maxinteger and ids[3] == math.mininteger)
+assert(#readings == 2 and readings[2] == 0.75)
+assert(#nested_counts == 2 and nested_counts[1][2] == 2 and nested_counts[2][1] == 3)
+)",
+	     sol::script_pass_on_error);
+	REQUIRE(result.valid());
+
+	sol::as_table_t<std::vector<double>> samples_back = lua["samples"];
+	REQUIRE(samples_back.value() == samples);
+	sol::as_table_t<std::array<int, 4>> counts_back = lua["counts"];
+	REQUIRE(counts_back.value() == counts);
+	lua.safe_script("short_counts = { 7, 8 } long_counts = { 9, 10, 11, 12, 13 }");
+	sol::as_table_t<std::array<int, 4>> short_back = lua["short_counts"];
+	REQUIRE(short_back.value()[0] == 7);
+	REQUIRE(short_back.value()[1] == 8);
+	sol::as_table_t<std::array<int, 4>> long_back = lua["long_counts"];
+	REQUIRE(long_back.value() == std::array<int, 4> { { 9, 10, 11, 12 } });
+
+	SECTION("precision") {
+		std::vector<std::uint64_t> large { 1, 0xFFFFFFFFFFFFFFFFull };
+		int top = lua_gettop(lua);
+		REQUIRE_THROWS(sol::stack::push(lua, sol::as_table(large)));
+		// the whole range is checked before the table is made
+		REQUIRE(lua_gettop(lua) == top);
+
+		std::vector<std::uint64_t> representable { 1, 0x8000000000000000ull };
+		sol::stack::push(lua, sol::as_table(representable));
+		sol::table t(lua, -1);
+		lua_pop(lua, 1);
+		REQUIRE(t.get<std::int64_t>(1) == 1);
+		REQUIRE(t.get<double>(2) == 9223372036854775808.0);
+	}
+}
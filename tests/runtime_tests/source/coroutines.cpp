@@ -725,3 +725,138 @@ TEST_CASE("coroutines/error_handler_state_transfer", "test that sol3 coroutines
 		luaCoroutines.pop_back();
 	}
 }
+
+TEST_CASE("coroutines/thread pool", "threads released into a thread_pool are reset and handed out again instead of creating new ones") {
+	sol::state lua;
+	lua.open_libraries(sol::lib::base, sol::lib::coroutine);
+	auto result = lua.safe_script(R"(
+function step(x)
+	local y = coroutine.yield(x + 1)
+	return y * 2
+end
+)",
+	     sol::script_pass_on_error);
+	REQUIRE(result.valid());
+
+	sol::thread_pool pool(lua, 2);
+	lua_State* first = nullptr;
+	{
+		sol::thread runner = pool.acquire();
+		first = runner.thread_state();
+		sol::coroutine co = runner.state()["step"];
+		int a = co(1);
+		int b = co(5);
+		REQUIRE(a == 2);
+		REQUIRE(b == 10);
+		REQUIRE(pool.release(runner));
+	}
+	REQUIRE(pool.size() == 1);
+	{
+		sol::thread runner = pool.acquire();
+		REQUIRE(runner.thread_state() == first);
+		sol::coroutine co = runner.state()["step"];
+		int a = co(20);
+		REQUIRE(a == 21);
+		// suspended in the middle of step: only Lua 5.4 can rewind it
+		bool recycled = pool.release(runner);
+		REQUIRE(recycled == (SOL_LUA_VESION_I_ >= 504));
+	}
+	sol::thread main_thread(lua, lua.lua_state());
+	REQUIRE_FALSE(pool.release(main_thread));
+
+	const sol::thread_pool_stats& stats = pool.stats();
+	REQUIRE(stats.misses == 1);
+	REQUIRE(stats.hits == 1);
+	REQUIRE(stats.recycled == ((SOL_LUA_VESION_I_ >= 504) ? 2u : 1u));
+	REQUIRE(stats.discarded == ((SOL_LUA_VESION_I_ >= 504) ? 1u : 2u));
+}
+
+TEST_CASE("coroutines/scheduler", "the scheduler only resumes tasks whose timer, frame count, predicate or signal has come due") {
+	sol::state lua;
+	lua.open_libraries(sol::lib::base, sol::lib::coroutine);
+	sol::scheduler sched(lua);
+	sched.register_functions(lua.globals());
+	std::vector<std::string> errors;
+	sched.set_error_callback([&errors](sol::scheduler::task_id, const std::string& message) { errors.push_back(message); });
+
+	auto result = lua.safe_script(R"(
+log = {}
+ready_flag = false
+function sleeper() wait(1.0) log[#log + 1] = "sleeper" end
+function framer() wait_frames(2) log[#log + 1] = "framer" end
+function poller() wait_until(function() return ready_flag end) log[#log + 1] = "poller" end
+function listener(name) wait_signal(name) log[#log + 1] = "listener " .. name end
+function yielder() coroutine.yield() log[#log + 1] = "yielder" end
+function broken() wait_frames(1) error("boom") end
+)",
+	     sol::script_pass_on_error);
+	REQUIRE(result.valid());
+
+	sched.start(lua["sleeper"]);
+	sched.start(lua["framer"]);
+	sched.start(lua["poller"]);
+	sched.start(lua["listener"], "go");
+	sched.start(lua["yielder"]);
+	sched.start(lua["broken"]);
+	REQUIRE(sched.size() == 6);
+
+	auto log_is = [&lua](std::vector<std::string> expected) {
+		sol::table log = lua["log"];
+		std::vector<std::string> actual;
+		for (std::size_t i = 1; i <= log.size(); ++i) {
+			actual.push_back(log[i]);
+		}
+		return actual == expected;
+	};
+
+	REQUIRE(sched.update(0.25) == 6);
+	REQUIRE(log_is({}));
+	REQUIRE(sched.update(0.25) == 2);
+	REQUIRE(log_is({ "yielder" }));
+	REQUIRE(errors.size() == 1);
+	REQUIRE(errors[0].find("boom") != std::string::npos);
+	REQUIRE(sched.update(0.25) == 1);
+	REQUIRE(log_is({ "yielder", "framer" }));
+	REQUIRE(sched.signal("go") == 1);
+	REQUIRE(sched.update(0.25) == 1);
+	REQUIRE(log_is({ "yielder", "framer", "listener go" }));
+	REQUIRE(sched.update(0.25) == 1);
+	REQUIRE(log_is({ "yielder", "framer", "listener go", "sleeper" }));
+	REQUIRE(sched.update(0.25) == 0);
+	lua["ready_flag"] = true;
+	REQUIRE(sched.update(0.25) == 1);
+	REQUIRE(log_is({ "yielder", "framer", "listener go", "sleeper", "poller" }));
+	REQUIRE(sched.size() == 0);
+
+	sol::scheduler::task_id sleeping = sched.start(lua["sleeper"]);
+	REQUIRE(sched.update(0.0) == 1);
+	REQUIRE(sched.running(sleeping));
+	REQUIRE(sched.cancel(sleeping));
+	REQUIRE_FALSE(sched.running(sleeping));
+	REQUIRE(sched.update(2.0) == 0);
+	REQUIRE(sched.size() == 0);
+
+	auto outside = lua.safe_script("wait(1)", sol::script_pass_on_error);
+	REQUIRE_FALSE(outside.valid());
+	auto outside_signal = lua.safe_script("wait_signal('go')", sol::script_pass_on_error);
+	REQUIRE_FALSE(outside_signal.valid());
+	auto outside_until = lua.safe_script("wait_until(function() return true end)", sol::script_pass_on_error);
+	REQUIRE_FALSE(outside_until.valid());
+}
+
+TEST_CASE("coroutines/scheduler destroyed", "functions registered by a scheduler raise an error once it is gone instead of touching it") {
+	sol::state lua;
+	lua.open_libraries(sol::lib::base, sol::lib::coroutine);
+	{
+		sol::scheduler sched(lua);
+		sched.register_functions(lua.globals());
+		lua.safe_script("saved_signal = signal saved_wait = wait");
+		REQUIRE(lua.safe_script("return signal('go')").get<std::size_t>() == 0);
+	}
+	auto after_signal = lua.safe_script("signal('go')", sol::script_pass_on_error);
+	REQUIRE_FALSE(after_signal.valid());
+	auto after_saved = lua.safe_script("saved_signal('go')", sol::script_pass_on_error);
+	REQUIRE_FALSE(after_saved.valid());
+	auto after_wait = lua.safe_script("coroutine.wrap(function() saved_wait(1) end)()", sol::script_pass_on_error);
+	REQUIRE_FALSE(after_wait.valid());
+}
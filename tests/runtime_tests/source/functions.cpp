@@ -372,6 +372,86 @@ TEST_CASE("functions/function_result and protected_function_result",
 	}
 }
 
+TEST_CASE("functions/default handler borrowing", "protected functions without their own handler use the state's default handler without holding a reference to it") {
+	sol::state lua;
+	sol::stack_guard luasg(lua);
+	lua.open_libraries(sol::lib::base);
+
+	auto result1 = lua.safe_script(R"(
+function boom() error("boom", 0) end
+function first_handler(msg) return "first: " .. msg end
+function second_handler(msg) return "second: " .. msg end
+)",
+	     sol::script_pass_on_error);
+	REQUIRE(result1.valid());
+
+	sol::protected_function::set_default_handler(lua["first_handler"]);
+	sol::protected_function boom = lua["boom"];
+	REQUIRE_FALSE(boom.error_handler.valid());
+	{
+		sol::protected_function_result result = boom();
+		REQUIRE_FALSE(result.valid());
+		sol::error err = result;
+		REQUIRE(err.what() == std::string("first: boom"));
+	}
+
+	sol::protected_function::set_default_handler(lua["second_handler"]);
+	{
+		sol::protected_function copied = boom;
+		sol::protected_function_result result = copied();
+		REQUIRE_FALSE(result.valid());
+		sol::error err = result;
+		REQUIRE(err.what() == std::string("second: boom"));
+	}
+	{
+		lua_State* L = lua.lua_state();
+		sol::stack::push(L, boom);
+		sol::stack_aligned_safe_function aligned(L, -1);
+		sol::protected_function_result result = aligned();
+		REQUIRE_FALSE(result.valid());
+		sol::error err = result;
+		REQUIRE(err.what() == std::string("second: boom"));
+	}
+
+	sol::protected_function fetched = sol::protected_function::get_default_handler(lua.lua_state());
+	REQUIRE(fetched.valid());
+
+	boom.error_handler = sol::lua_nil;
+	{
+		sol::protected_function_result result = boom();
+		REQUIRE_FALSE(result.valid());
+		sol::error err = result;
+		REQUIRE(err.what() == std::string("boom"));
+	}
+
+	// a nil handler passed in on purpose is not the default handler
+	sol::protected_function explicit_nil(lua["boom"], sol::reference(lua.lua_state(), sol::lua_nil));
+	REQUIRE_FALSE(explicit_nil.error_handler.valid());
+	{
+		sol::protected_function_result result = explicit_nil();
+		REQUIRE_FALSE(result.valid());
+		sol::error err = result;
+		REQUIRE(err.what() == std::string("boom"));
+	}
+	{
+		sol::protected_function copied = explicit_nil;
+		sol::protected_function moved = std::move(copied);
+		sol::protected_function_result result = moved();
+		REQUIRE_FALSE(result.valid());
+		sol::error err = result;
+		REQUIRE(err.what() == std::string("boom"));
+	}
+	{
+		lua_State* L = lua.lua_state();
+		sol::stack::push(L, explicit_nil);
+		sol::stack_aligned_safe_function aligned(L, -1, sol::reference(L, sol::lua_nil));
+		sol::protected_function_result result = aligned();
+		REQUIRE_FALSE(result.valid());
+		sol::error err = result;
+		REQUIRE(err.what() == std::string("boom"));
+	}
+}
+
 #if SOL_IS_OFF(SOL_COMPILER_VCXX_CLANG_I_) \
      && (!defined(SOL2_CI) && !(SOL2_CI) && ((!defined(_M_IX86) || defined(_M_IA64)) || (defined(_WIN64)) || (defined(__LLP64__) || defined(__LP64__))))
 TEST_CASE("functions/safe protected_function_result handlers",
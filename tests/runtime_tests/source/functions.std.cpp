@@ -234,3 +234,44 @@ TEST_CASE("functions/set_function already wrapped", "setting a function returned
 		}
 	}
 }
+
+TEST_CASE("functions/lua_callback", "lua_callback holds a Lua function with a fixed signature, converts from the stack and round-trips back to the same function") {
+	sol::state lua;
+	sol::stack_guard luasg(lua);
+	lua.open_libraries(sol::lib::base);
+
+	auto result = lua.safe_script(R"(
+function add(a, b) return a + b end
+function pair(x) return x, x * 2 end
+calls = 0
+function bump() calls = calls + 1 end
+)",
+	     sol::script_pass_on_error);
+	REQUIRE(result.valid());
+
+	sol::lua_callback<int(int, int)> add = lua["add"];
+	REQUIRE(add);
+	REQUIRE(add(2, 3) == 5);
+
+	sol::lua_callback<std::tuple<int, int>(int)> pair = lua["pair"];
+	std::tuple<int, int> both = pair(21);
+	REQUIRE(std::get<0>(both) == 21);
+	REQUIRE(std::get<1>(both) == 42);
+
+	std::vector<sol::lua_callback<void()>> listeners(3, lua["bump"].get<sol::lua_callback<void()>>());
+	for (const auto& listener : listeners) {
+		listener();
+	}
+	REQUIRE(lua["calls"].get<int>() == 3);
+
+	std::function<int(int, int)> as_std = add;
+	REQUIRE(as_std(4, 5) == 9);
+
+	lua.set_function("apply", [](sol::lua_callback<int(int, int)> f, int a, int b) { return f(a, b); });
+	lua["same"] = add;
+	auto result2 = lua.safe_script("assert(apply(add, 6, 7) == 13) assert(rawequal(same, add))", sol::script_pass_on_error);
+	REQUIRE(result2.valid());
+
+	sol::lua_callback<void()> missing = lua["does_not_exist"];
+	REQUIRE_FALSE(missing);
+}
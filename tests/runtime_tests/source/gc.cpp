@@ -31,6 +31,42 @@
 #include <vector>
 #include <memory>
 #include <set>
+#include <stdexcept>
+
+struct pooled_vec {
+	static inline int destroyed = 0;
+
+	double x = 0;
+	double y = 0;
+
+	pooled_vec() = default;
+	pooled_vec(double x_, double y_) : x(x_), y(y_) {
+	}
+	~pooled_vec() {
+		++destroyed;
+	}
+};
+
+template <>
+struct sol::usertype_allocation_policy<pooled_vec> : sol::usertype_pool<pooled_vec, 8> { };
+
+struct pooled_failing {
+	static inline int destroyed = 0;
+
+	int value = 0;
+
+	pooled_failing(int value_) : value(value_) {
+		if (value < 0) {
+			throw std::runtime_error("negative");
+		}
+	}
+	~pooled_failing() {
+		++destroyed;
+	}
+};
+
+template <>
+struct sol::usertype_allocation_policy<pooled_failing> : sol::usertype_pool<pooled_failing, 8> { };
 
 TEST_CASE("gc/destructors", "test if destructors are fired properly through gc of unbound usertypes") {
 	struct test;
@@ -414,6 +450,77 @@ TEST_CASE("gc/usertypes", "show that proper copies / destruction happens for use
 	}
 }
 
+TEST_CASE("gc/pooled usertypes", "values of pooled usertypes live in the pool and hand their slots back on collection") {
+	using pool = sol::usertype_pool<pooled_vec, 8>;
+	static_assert(sol::is_usertype_pooled_v<pooled_vec>);
+	pooled_vec::destroyed = 0;
+	std::size_t slots_before = pool::stats().slots_in_use;
+	{
+		sol::state lua;
+		lua.open_libraries(sol::lib::base);
+		lua.new_usertype<pooled_vec>("pooled_vec",
+		     sol::constructors<pooled_vec(), pooled_vec(double, double)>(),
+		     "x",
+		     &pooled_vec::x,
+		     "y",
+		     &pooled_vec::y,
+		     sol::meta_function::addition,
+		     [](const pooled_vec& l, const pooled_vec& r) { return pooled_vec(l.x + r.x, l.y + r.y); });
+		lua["kept"] = pooled_vec(1, 2);
+		REQUIRE(pool::stats().slots_in_use == slots_before + 1);
+
+		auto result = lua.safe_script(R"(
+local acc = pooled_vec.new(0, 0)
+for i = 1, 100 do
+	acc = acc + pooled_vec.new(i, -i)
+end
+total = acc
+)",
+		     sol::script_pass_on_error);
+		REQUIRE(result.valid());
+		lua.collect_garbage();
+		lua.collect_garbage();
+		pooled_vec& total = lua["total"];
+		REQUIRE(total.x == 5050);
+		REQUIRE(total.y == -5050);
+		pooled_vec& kept = lua["kept"];
+		REQUIRE(kept.x == 1);
+		REQUIRE(kept.y == 2);
+
+		sol::usertype_pool_stats stats = pool::stats();
+		REQUIRE(stats.slots_in_use == slots_before + 2);
+		REQUIRE(stats.peak_slots_in_use > stats.slots_in_use);
+		REQUIRE(stats.slabs * 8 == stats.slots_in_use + stats.slots_free);
+	}
+	REQUIRE(pool::stats().slots_in_use == slots_before);
+	REQUIRE(pooled_vec::destroyed > 200);
+}
+
+TEST_CASE("gc/pooled usertypes failed construction", "a pooled slot goes back to the pool when constructing into it throws") {
+	using pool = sol::usertype_pool<pooled_failing, 8>;
+	pooled_failing::destroyed = 0;
+	std::size_t slots_before = pool::stats().slots_in_use;
+	{
+		sol::state lua;
+		lua.open_libraries(sol::lib::base);
+		lua.new_usertype<pooled_failing>("pooled_failing", sol::constructors<pooled_failing(int)>(), "value", &pooled_failing::value);
+
+		auto failed = lua.safe_script("return pooled_failing.new(-1)", sol::script_pass_on_error);
+		REQUIRE_FALSE(failed.valid());
+		REQUIRE(pool::stats().slots_in_use == slots_before);
+
+		auto made = lua.safe_script("kept = pooled_failing.new(3)", sol::script_pass_on_error);
+		REQUIRE(made.valid());
+		REQUIRE(pool::stats().slots_in_use == slots_before + 1);
+		lua.collect_garbage();
+		lua.collect_garbage();
+		REQUIRE(pooled_failing::destroyed == 0);
+		REQUIRE(lua["kept"]["value"].get<int>() == 3);
+	}
+	REQUIRE(pool::stats().slots_in_use == slots_before);
+	REQUIRE(pooled_failing::destroyed == 1);
+}
+
 TEST_CASE("gc/double-deletion tests", "make sure usertypes are properly destructed and don't double-delete memory or segfault") {
 	class crash_class {
 	public:
@@ -26,6 +26,7 @@
 #include <catch.hpp>
 
 #include <iostream>
+#include <type_traits>
 
 TEST_CASE("proxy/function results", "make sure that function results return proper proxies and can be indexed nicely") {
 	sol::state lua;
@@ -97,3 +98,29 @@ TEST_CASE("proxy/equality", "check to make sure equality tests work") {
 	REQUIRE_FALSE((lua["a"] != 2));
 #endif // clang screws up by trying to access int128 types that it doesn't support, even when we don't ask for them
 }
+
+TEST_CASE("proxy/borrowed tables", "chained lookups borrow lvalue tables and move owned ones instead of copying references") {
+	sol::state lua;
+	sol::stack_guard luasg(lua);
+	lua.safe_script("config = { server = { limits = { connections = 128 } } }");
+
+	sol::table config = lua["config"];
+	auto borrowed = config["server"]["limits"]["connections"];
+	static_assert(std::is_reference_v<decltype(borrowed.tbl)>, "proxies from an lvalue table must borrow it");
+	REQUIRE(&borrowed.tbl == &config);
+	REQUIRE(borrowed.get<int>() == 128);
+	config["server"]["limits"]["connections"] = 256;
+	REQUIRE(lua["config"]["server"]["limits"]["connections"].get<int>() == 256);
+
+	auto owned = lua.get<sol::table>("config")["server"]["limits"]["connections"];
+	static_assert(!std::is_reference_v<decltype(owned.tbl)>, "proxies from a temporary table must own it");
+	REQUIRE(owned.tbl.valid());
+	REQUIRE(owned.get<int>() == 256);
+	owned = 512;
+	REQUIRE(config["server"]["limits"]["connections"].get<int>() == 512);
+
+	auto source = lua.get<sol::table>("config")["server"];
+	auto moved = std::move(source)["limits"]["connections"];
+	REQUIRE_FALSE(source.tbl.valid());
+	REQUIRE(moved.get<int>() == 512);
+}
@@ -23,6 +23,10 @@
 
 #include "sol_test.hpp"
 
+#include <sol/state_pool.hpp>
+#include <sol/bytecode_cache.hpp>
+#include <sol/mapped_file.hpp>
+
 #include <catch.hpp>
 
 #include <iostream>
@@ -31,6 +35,7 @@
 #include <thread>
 #include <mutex>
 #include <atomic>
+#include <future>
 
 template <typename Name, typename Data>
 void write_file_attempt(Name&& filename, Data&& data) {
@@ -700,3 +705,134 @@ TEST_CASE("state/script function returns", "make sure that returned functions ar
 		REQUIRE(v1 == 1);
 	}
 }
+
+TEST_CASE("state/state_pool", "a state_pool runs calls on independent, identically initialized states and hands results back through futures") {
+	sol::bytecode code;
+	{
+		sol::state lua;
+		sol::load_result loaded = lua.load("function score(a, b) return a * 10 + b end function fail() error('nope') end");
+		REQUIRE(loaded.valid());
+		sol::protected_function chunk = loaded;
+		code = chunk.dump();
+	}
+
+	sol::state_pool pool(4, [&code](sol::state& lua) {
+		lua.open_libraries(sol::lib::base);
+		lua.safe_script(code.as_string_view(), sol::script_throw_on_error);
+	});
+	REQUIRE(pool.size() == 4);
+
+	std::vector<std::future<int>> results;
+	for (int i = 0; i < 200; ++i) {
+		results.push_back(pool.call<int>("score", i, 1));
+	}
+	for (int i = 0; i < 200; ++i) {
+		REQUIRE(results[static_cast<std::size_t>(i)].get() == i * 10 + 1);
+	}
+
+	std::future<int> failed = pool.call<int>("fail");
+	REQUIRE_THROWS_AS(failed.get(), sol::error);
+	std::future<void> missing = pool.call("does_not_exist");
+	REQUIRE_THROWS_AS(missing.get(), sol::error);
+
+	std::future<std::string> custom = pool.submit([](sol::state& lua) { return lua.safe_script("return _VERSION").get<std::string>(); });
+	REQUIRE(custom.get().find("Lua") != std::string::npos);
+
+	REQUIRE_THROWS(sol::state_pool(2, [](sol::state&) { throw std::runtime_error("initialization failed"); }));
+}
+
+TEST_CASE("state/bytecode cache", "script files are compiled once and then loaded from memory or the cache directory until they change") {
+	const std::filesystem::path directory = "./tmp_bytecode_cache";
+	const std::string script_name = "./tmp_bytecode_cache.lua";
+	std::filesystem::remove_all(directory);
+	auto write_script = [&script_name](const char* code) {
+		std::ofstream out(script_name, std::ios::binary | std::ios::trunc);
+		out << code;
+	};
+	write_script("return 1 + 1");
+
+	{
+		sol::bytecode_cache cache(directory);
+		sol::state lua;
+		cache.install(lua);
+		REQUIRE(lua.safe_script_file(script_name).get<int>() == 2);
+		REQUIRE(lua.safe_script_file(script_name).get<int>() == 2);
+		sol::object module = lua.require_file("tmp_module", script_name, false);
+		REQUIRE(module.as<int>() == 2);
+		sol::bytecode_cache_stats stats = cache.stats();
+		REQUIRE(stats.misses == 1);
+		REQUIRE(stats.hits == 2);
+		REQUIRE(cache.size() == 1);
+
+		// a different size means a different file, so it is parsed again
+		write_script("return 40 + 2");
+		REQUIRE(lua.safe_script_file(script_name).get<int>() == 42);
+		REQUIRE(cache.stats().misses == 2);
+
+		auto broken = lua.safe_script_file("./does_not_exist.lua", sol::script_pass_on_error);
+		REQUIRE_FALSE(broken.valid());
+
+		// the cached chunk is binary, but the file is source: the mode still decides, not the cache
+		sol::load_result as_binary = lua.load_file(script_name, sol::load_mode::binary);
+		REQUIRE_FALSE(as_binary.valid());
+		sol::load_result as_text = lua.load_file(script_name, sol::load_mode::text);
+		REQUIRE(as_text.valid());
+		REQUIRE(cache.stats().hits == 2);
+		sol::bytecode_cache::uninstall(lua);
+	}
+	{
+		sol::bytecode_cache cache(directory);
+		sol::state lua;
+		cache.install(lua);
+		REQUIRE(lua.safe_script_file(script_name).get<int>() == 42);
+		sol::bytecode_cache_stats stats = cache.stats();
+		REQUIRE(stats.disk_hits == 1);
+		REQUIRE(stats.misses == 0);
+	}
+
+	std::remove(script_name.c_str());
+	std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("state/mapped files", "source and bytecode files load straight from a read-only mapping with the same results as luaL_loadfilex") {
+	const std::string source_name = "./tmp_mapped_source.lua";
+	const std::string bytecode_name = "./tmp_mapped_bytecode.luac";
+	{
+		std::ofstream out(source_name, std::ios::binary | std::ios::trunc);
+		out << "#!/usr/bin/env lua\nlocal x = 20\nreturn x + 1, debug_line()\n";
+	}
+
+	sol::state lua;
+	lua.open_libraries(sol::lib::base, sol::lib::debug);
+	lua.safe_script("function debug_line() return debug.getinfo(2, 'l').currentline end");
+
+	sol::load_result loaded = sol::load_mapped_file(lua, source_name);
+	REQUIRE(loaded.valid());
+	sol::protected_function chunk = loaded;
+	std::tuple<int, int> results = chunk();
+	REQUIRE(std::get<0>(results) == 21);
+	// the '#' line is skipped but still counted
+	REQUIRE(std::get<1>(results) == 3);
+
+	sol::bytecode code = chunk.dump();
+	{
+		std::ofstream out(bytecode_name, std::ios::binary | std::ios::trunc);
+		out.write(reinterpret_cast<const char*>(code.data()), static_cast<std::streamsize>(code.size()));
+	}
+	sol::mapped_file mapped(bytecode_name);
+	REQUIRE(mapped.valid());
+	REQUIRE(mapped.size() == code.size());
+	auto from_mapping = lua.safe_script(mapped.as_string_view(), sol::script_pass_on_error);
+	REQUIRE(from_mapping.valid());
+	REQUIRE(from_mapping.get<int>() == 21);
+
+	sol::mapped_file_loader loader;
+	loader.install(lua);
+	REQUIRE(lua.safe_script_file(bytecode_name).get<int>() == 21);
+	auto missing = lua.safe_script_file("./does_not_exist.lua", sol::script_pass_on_error);
+	REQUIRE_FALSE(missing.valid());
+	sol::mapped_file_loader::uninstall(lua);
+
+	std::remove(source_name.c_str());
+	std::remove(bytecode_name.c_str());
+}
@@ -253,6 +253,53 @@ TEST_CASE("stack/strings", "test that strings can be roundtripped") {
 	}
 }
 
+TEST_CASE("strings/long unicode", "long and mostly-ASCII strings convert the same way as short ones, including invalid input") {
+	sol::state lua;
+	sol::stack_guard luasg(lua);
+
+	std::u16string u16;
+	std::u32string u32;
+	std::string u8;
+	for (int i = 0; i < 700; ++i) {
+		u16 += u"The quick brown fox ";
+		u32 += U"The quick brown fox ";
+		u8 += "The quick brown fox ";
+		if (i % 97 == 0) {
+			u16 += u"\u00A9\u2603\U0001F34C";
+			u32 += U"\u00A9\u2603\U0001F34C";
+			u8 += "\xC2\xA9\xE2\x98\x83\xF0\x9F\x8D\x8C";
+		}
+	}
+
+	lua["u16"] = u16;
+	lua["u32"] = u32;
+	std::string from_u16 = lua["u16"];
+	std::string from_u32 = lua["u32"];
+	REQUIRE(from_u16 == u8);
+	REQUIRE(from_u32 == u8);
+
+	lua["u8"] = u8;
+	std::u16string to_u16 = lua["u8"];
+	std::u32string to_u32 = lua["u8"];
+	std::wstring to_wide = lua["u8"];
+	REQUIRE(to_u16 == u16);
+	REQUIRE(to_u32 == u32);
+	REQUIRE(to_wide.size() == (sizeof(wchar_t) == 2 ? u16.size() : u32.size()));
+
+	// lone surrogates and broken UTF-8 become U+FFFD, one per bad code unit
+	std::u16string broken16 = u"jumps over the lazy dog, jumps over the lazy dog ";
+	broken16 += static_cast<char16_t>(0xDC00);
+	broken16 += u"tail";
+	broken16 += static_cast<char16_t>(0xD800);
+	lua["broken16"] = broken16;
+	std::string from_broken16 = lua["broken16"];
+	REQUIRE(from_broken16 == "jumps over the lazy dog, jumps over the lazy dog \xEF\xBF\xBDtail\xEF\xBF\xBD");
+
+	lua["broken8"] = std::string("jumps over the lazy dog, jumps over the lazy dog \xFF tail");
+	std::u32string from_broken8 = lua["broken8"];
+	REQUIRE(from_broken8 == U"jumps over the lazy dog, jumps over the lazy dog \uFFFD tail");
+}
+
 TEST_CASE("detail/demangling", "test some basic demangling cases") {
 	std::string teststr = sol::detail::short_demangle<test>();
 	std::string nsteststr = sol::detail::short_demangle<muh_namespace::ns_test>();
@@ -263,6 +310,23 @@ TEST_CASE("detail/demangling", "test some basic demangling cases") {
 	REQUIRE(nsateststr == "ns_anon_test");
 }
 
+TEST_CASE("detail/compile-time demangling", "names and registry keys are worked out entirely at compile time") {
+	constexpr sol::string_view name = sol::detail::demangle_view<muh_namespace::ns_test>();
+	constexpr sol::string_view short_name = sol::detail::short_demangle_view<muh_namespace::ns_anon_test>();
+	constexpr sol::string_view key = sol::usertype_traits<test>::metatable_view();
+	constexpr std::uint64_t id = sol::usertype_traits<test>::type_id();
+	static_assert(name == "muh_namespace::ns_test");
+	static_assert(short_name == "ns_anon_test");
+	static_assert(key == "sol.test");
+	static_assert(id == sol::detail::usertype_type_id("test"));
+
+	REQUIRE(key.data()[key.size()] == '\0');
+	REQUIRE(sol::usertype_traits<test>::user_metatable() == "sol.test.user");
+	REQUIRE(sol::usertype_traits<test>::metatable().c_str() == std::string("sol.test"));
+	REQUIRE(sol::detail::demangle<muh_namespace::ns_test>() == name);
+	REQUIRE(sol::usertype_traits<muh_namespace::ns_test>::name() == "ns_test");
+}
+
 TEST_CASE("object/string-pushers", "test some basic string pushers with in_place constructor") {
 	sol::state lua;
 
@@ -149,3 +149,68 @@ TEST_CASE("tables/operator[] optional", "Test if proxies on tables can lazily ev
 	REQUIRE(non_nope4.value() == 35);
 }
 
+
+TEST_CASE("tables/key_path", "a key_path is pushed once and reused to walk nested tables") {
+	sol::state lua;
+	sol::stack_guard luasg(lua);
+	lua.open_libraries(sol::lib::base);
+	lua.safe_script(R"(
+		a = { server = { limits = { connections = 128 }, list = { 10, 20, 30 } } }
+		b = { server = { limits = { connections = 256 } } }
+		c = { server = 24 }
+	)");
+
+	sol::key_path connections(lua, "server", "limits", "connections");
+	sol::key_path second(lua, "server", "list", 2);
+	REQUIRE(connections.size() == 3);
+
+	sol::table a = lua["a"];
+	sol::table b = lua["b"];
+	sol::table c = lua["c"];
+	REQUIRE(a.get<int>(connections) == 128);
+	REQUIRE(b.get<int>(connections) == 256);
+	REQUIRE(a.get<int>(second) == 20);
+	REQUIRE(lua.get<int>(sol::key_path(lua, "a", "server", "list", 3)) == 30);
+
+	sol::optional<int> maybe_missing = c.get<sol::optional<int>>(connections);
+	REQUIRE_FALSE(maybe_missing.has_value());
+	REQUIRE(c.get_or(connections, 16) == 16);
+	REQUIRE(b.get_or(connections, 16) == 256);
+
+	a.set(connections, 512);
+	b[connections] = 1024;
+	REQUIRE(a["server"]["limits"]["connections"].get<int>() == 512);
+	REQUIRE(b["server"]["limits"]["connections"].get<int>() == 1024);
+	REQUIRE(b[connections].valid());
+	REQUIRE_FALSE(c[connections].valid());
+
+	sol::key_path server(lua, "server");
+	REQUIRE(a[server]["limits"]["connections"].get<int>() == 512);
+
+	sol::key_path copied = connections;
+	sol::key_path moved = std::move(copied);
+	REQUIRE(copied.empty());
+	REQUIRE(a.get<int>(moved) == 512);
+
+	auto result = lua.safe_script("return a.server.limits.connections + b.server.limits.connections", sol::script_pass_on_error);
+	REQUIRE(result.valid());
+	REQUIRE(result.get<int>() == 1536);
+}
+
+TEST_CASE("tables/key_path other state", "a key_path raises an error when used with a state other than the one that built it") {
+	sol::state lua;
+	sol::state other;
+	sol::stack_guard luasg(lua);
+	lua.open_libraries(sol::lib::base);
+	other.open_libraries(sol::lib::base);
+	other.safe_script("a = { server = { port = 80 } }");
+
+	sol::key_path port(lua, "server", "port");
+	sol::table a = other["a"];
+	other.set_function("read_port", [&]() { return a.get<int>(port); });
+	auto result = other.safe_script("return read_port()", sol::script_pass_on_error);
+	REQUIRE_FALSE(result.valid());
+
+	sol::key_path own_port(other, "server", "port");
+	REQUIRE(a.get<int>(own_port) == 80);
+}
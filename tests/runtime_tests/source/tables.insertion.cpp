@@ -193,3 +193,60 @@ TEST_CASE("tables/get create_if_nil", "create tables all the way down") {
 		REQUIRE(static_cast<bool>(totally_there));
 	}
 }
+
+TEST_CASE("tables/table_schema", "whole structs written to and read from tables through a schema") {
+	struct header {
+		int version = 0;
+	};
+	struct message : header {
+		int id = 0;
+		double weight = 0.0;
+		std::string name;
+		bool urgent = false;
+	};
+
+	sol::state lua;
+	sol::stack_guard luasg(lua);
+	lua.open_libraries(sol::lib::base);
+
+	sol::table_schema<message> schema(
+	     lua, "version", &message::version, "id", &message::id, "weight", &message::weight, "name", &message::name, "urgent", &message::urgent);
+	REQUIRE(schema.size() == 5);
+
+	message m;
+	m.version = 2;
+	m.id = 42;
+	m.weight = 1.5;
+	m.name = "ping";
+	m.urgent = true;
+
+	sol::table t = schema.create(lua, m);
+	REQUIRE(t.get<int>("version") == 2);
+	REQUIRE(t.get<int>("id") == 42);
+	REQUIRE(t.get<double>("weight") == 1.5);
+	REQUIRE(t.get<std::string>("name") == "ping");
+	REQUIRE(t.get<bool>("urgent"));
+
+	lua.safe_script("function handle(msg) return msg.name .. ':' .. msg.id end");
+	sol::protected_function handle = lua["handle"];
+	std::string handled = handle(schema.to_lua(m));
+	REQUIRE(handled == "ping:42");
+
+	lua.safe_script("reply = { id = 7, name = 'pong', weight = 0.25 }");
+	message back = schema.read(lua["reply"].get<sol::table>());
+	REQUIRE(back.id == 7);
+	REQUIRE(back.name == "pong");
+	REQUIRE(back.weight == 0.25);
+	REQUIRE(back.version == 0);
+	REQUIRE_FALSE(back.urgent);
+
+	m.id = 43;
+	schema.write(t, m);
+	REQUIRE(t.get<int>("id") == 43);
+	message round_trip;
+	schema.read(t, round_trip);
+	REQUIRE(round_trip.version == 2);
+	REQUIRE(round_trip.id == 43);
+	REQUIRE(round_trip.name == "ping");
+	REQUIRE(round_trip.urgent);
+}
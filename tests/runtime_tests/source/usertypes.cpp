@@ -205,6 +205,87 @@ TEST_CASE("usertype/basic type information", "check that we can query some basic
 	lua.safe_script("print(getmetatable(obj).__type.name)");
 }
 
+TEST_CASE("usertype/repeated checks", "type checks stay correct when metatable identities are served from the per-state cache") {
+	struct checked_thing {};
+	struct other_checked_thing {};
+
+	for (int state_index = 0; state_index < 2; ++state_index) {
+		sol::state lua;
+		sol::stack_guard luasg(lua);
+		lua.open_libraries(sol::lib::base);
+
+		lua.new_usertype<checked_thing>("checked_thing");
+		lua.new_usertype<other_checked_thing>("other_checked_thing");
+		lua.set_function("take_thing", [](checked_thing&) { return true; });
+
+		lua.safe_script("obj = checked_thing.new() other = other_checked_thing.new()");
+		for (int i = 0; i < 3; ++i) {
+			sol::object obj = lua["obj"];
+			sol::object other = lua["other"];
+			REQUIRE(obj.is<checked_thing>());
+			REQUIRE(obj.is<checked_thing*>());
+			REQUIRE_FALSE(obj.is<other_checked_thing>());
+			REQUIRE(other.is<other_checked_thing>());
+			REQUIRE_FALSE(other.is<checked_thing>());
+		}
+		auto good_result = lua.safe_script("assert(take_thing(obj))", sol::script_pass_on_error);
+		REQUIRE(good_result.valid());
+		auto bad_result = lua.safe_script("take_thing(other)", sol::script_pass_on_error);
+		REQUIRE_FALSE(bad_result.valid());
+	}
+}
+
+TEST_CASE("usertype/metatables by type key", "metatables found through the per-type registry slot are the ones registered by name") {
+	struct named_base {
+		int value() const {
+			return 24;
+		}
+	};
+	struct named_derived : named_base {};
+	struct never_registered {};
+
+	sol::state lua;
+	sol::stack_guard luasg(lua);
+	lua.open_libraries(sol::lib::base);
+
+	lua.new_usertype<named_base>("named_base", "value", &named_base::value);
+	lua.new_usertype<named_derived>("named_derived", sol::base_classes, sol::bases<named_base>());
+
+	named_derived d;
+	for (int i = 0; i < 3; ++i) {
+		lua["by_value"] = named_derived {};
+		lua["by_pointer"] = &d;
+		lua["by_unique"] = std::make_unique<named_derived>();
+		lua["unregistered"] = never_registered {};
+		lua["unregistered_too"] = never_registered {};
+
+		auto result = lua.safe_script(R"(
+			assert(by_value:value() == 24)
+			assert(by_pointer:value() == 24)
+			assert(by_unique:value() == 24)
+			assert(getmetatable(unregistered) == getmetatable(unregistered_too))
+		)",
+		     sol::script_pass_on_error);
+		REQUIRE(result.valid());
+
+		sol::object by_value = lua["by_value"];
+		by_value.push();
+		lua_getmetatable(lua, -1);
+		luaL_getmetatable(lua, &sol::usertype_traits<named_derived>::metatable()[0]);
+		REQUIRE(lua_rawequal(lua, -1, -2) == 1);
+		lua_pop(lua, 3);
+
+		sol::object unregistered = lua["unregistered"];
+		unregistered.push();
+		lua_getmetatable(lua, -1);
+		luaL_getmetatable(lua, &sol::usertype_traits<never_registered>::metatable()[0]);
+		REQUIRE(lua_rawequal(lua, -1, -2) == 1);
+		lua_pop(lua, 3);
+
+		REQUIRE(lua["by_pointer"].get<named_derived*>() == &d);
+	}
+}
+
 #if !defined(_MSC_VER) || !(defined(_WIN32) && !defined(_WIN64))
 
 TEST_CASE("usertype/noexcept-methods", "make sure noexcept functions and methods can be bound to usertypes without issues") {
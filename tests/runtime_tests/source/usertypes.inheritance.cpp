@@ -105,6 +105,35 @@ TEST_CASE("inheritance/basic", "test that metatables are properly inherited") {
 	REQUIRE(a == 5);
 }
 
+TEST_CASE("inheritance/derived to base arguments", "passing a derived object where a base is expected picks the correct base by type id") {
+	sol::state lua;
+	lua.open_libraries(sol::lib::base);
+	lua.new_usertype<inh_test_A>("A", "a", &inh_test_A::a);
+	lua.new_usertype<inh_test_B>("B", "b", &inh_test_B::b);
+	lua.new_usertype<inh_test_C>("C", "c", &inh_test_C::c, sol::base_classes, sol::bases<inh_test_B, inh_test_A>());
+	lua.new_usertype<inh_test_D>("D", "d", &inh_test_D::d, sol::base_classes, sol::bases<inh_test_C, inh_test_B, inh_test_A>());
+
+	inh_test_D obj;
+	lua["obj"] = &obj;
+	lua["take_a"] = [&obj](inh_test_A& a) { return &a == static_cast<inh_test_A*>(&obj); };
+	lua["take_b"] = [&obj](inh_test_B* b) { return b == static_cast<inh_test_B*>(&obj); };
+	lua["take_c"] = [&obj](const inh_test_C& c) { return &c == static_cast<inh_test_C*>(&obj); };
+	lua["take_d"] = [&obj](inh_test_D& d) { return &d == &obj; };
+
+	REQUIRE(sol::usertype_traits<inh_test_A>::type_id() != sol::usertype_traits<inh_test_B>::type_id());
+	auto result = lua.safe_script(R"(
+assert(take_a(obj))
+assert(take_b(obj))
+assert(take_c(obj))
+assert(take_d(obj))
+)",
+	     sol::script_pass_on_error);
+	REQUIRE(result.valid());
+
+	auto bad_result = lua.safe_script("take_d(A.new())", sol::script_pass_on_error);
+	REQUIRE_FALSE(bad_result.valid());
+}
+
 TEST_CASE("inheritance/usertype derived non-hiding", "usertype classes must play nice when a derived class does not overload a publically visible base function") {
 	sol::state lua;
 	lua.open_libraries(sol::lib::base);
@@ -89,3 +89,50 @@ TEST_CASE("usertype/overloading_values", "ensure overloads handle properly") {
 	REQUIRE(res4 == 524);
 	std::cout << "----- end of 8" << std::endl;
 }
+
+TEST_CASE("usertype/overloading_same_arity", "ensure overloads that share an arity are told apart by their argument types, in declaration order") {
+	struct vec2 {
+		double x = 0;
+		double y = 0;
+	};
+
+	sol::state lua;
+	sol::stack_guard luasg(lua);
+	lua.open_libraries(sol::lib::base);
+
+	lua.new_usertype<vec2>("vec2", sol::constructors<vec2()>(), "x", &vec2::x, "y", &vec2::y);
+	lua.set_function("describe",
+	     sol::overload([](const vec2&, const vec2&) { return std::string("vec2 vec2"); },
+	          [](const vec2&, double) { return std::string("vec2 number"); },
+	          [](double, const vec2&) { return std::string("number vec2"); },
+	          [](const std::string&, sol::table) { return std::string("string table"); },
+	          [](double, double) { return std::string("number number"); },
+	          [](sol::object, sol::object) { return std::string("object object"); }));
+
+	auto result = lua.safe_script(R"(
+v = vec2.new()
+a = describe(v, v)
+b = describe(v, 2)
+c = describe(2, v)
+d = describe("2", {})
+e = describe(1, 2)
+f = describe(true, false)
+g = describe({}, v)
+)",
+	     sol::script_pass_on_error);
+	REQUIRE(result.valid());
+	std::string a = lua["a"];
+	std::string b = lua["b"];
+	std::string c = lua["c"];
+	std::string d = lua["d"];
+	std::string e = lua["e"];
+	std::string f = lua["f"];
+	std::string g = lua["g"];
+	REQUIRE(a == "vec2 vec2");
+	REQUIRE(b == "vec2 number");
+	REQUIRE(c == "number vec2");
+	REQUIRE(d == "string table");
+	REQUIRE(e == "number number");
+	REQUIRE(f == "object object");
+	REQUIRE(g == "object object");
+}
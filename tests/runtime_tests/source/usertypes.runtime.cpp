@@ -575,3 +575,51 @@ TEST_CASE("usertypes/static new index and static index", "ensure static index an
 	REQUIRE(static_special_property_object::named_get_calls == 1);
 	REQUIRE(static_special_property_object::named_set_calls == 1);
 }
+
+TEST_CASE("usertype/freeze", "frozen usertypes look up keys by interned string and still see runtime additions") {
+	struct frozen_object {
+		int value = 11;
+		int get_value() const {
+			return value;
+		}
+	};
+
+	sol::state lua;
+	lua.open_libraries(sol::lib::base);
+
+	sol::usertype<frozen_object> ut = lua.new_usertype<frozen_object>("frozen_object", "value", &frozen_object::value, "get_value", &frozen_object::get_value);
+	REQUIRE_FALSE(ut.is_frozen());
+	ut.freeze();
+	REQUIRE(ut.is_frozen());
+
+	sol::optional<sol::error> result0 = lua.safe_script(R"(
+		local f = frozen_object.new()
+		assert(f.value == 11)
+		f.value = 24
+		assert(f:get_value() == 24)
+		assert(f.does_not_exist == nil)
+	)",
+	     sol::script_pass_on_error);
+	REQUIRE_FALSE(result0.has_value());
+
+	ut["a_rather_long_member_name_that_lua_will_not_intern_at_all"] = [](const frozen_object& self) { return self.value * 2; };
+	ut["doubled"] = [](const frozen_object& self) { return self.value * 2; };
+	REQUIRE(ut.is_frozen());
+
+	sol::optional<sol::error> result1 = lua.safe_script(R"(
+		local f = frozen_object.new()
+		assert(f:doubled() == 22)
+		assert(f:a_rather_long_member_name_that_lua_will_not_intern_at_all() == 22)
+	)",
+	     sol::script_pass_on_error);
+	REQUIRE_FALSE(result1.has_value());
+
+	ut.thaw();
+	REQUIRE_FALSE(ut.is_frozen());
+	sol::optional<sol::error> result2 = lua.safe_script(R"(
+		local f = frozen_object.new()
+		assert(f:doubled() == 22)
+	)",
+	     sol::script_pass_on_error);
+	REQUIRE_FALSE(result2.has_value());
+}